@@ -0,0 +1,150 @@
+#ifndef DISPLAY_MODEL_H
+#define DISPLAY_MODEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ssd1306_fb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DISPLAY_MAX_WIDGETS         8
+#define DISPLAY_WIDGET_TEXT_MAX     22  // 21 columns of the 6 px font + NUL
+
+/**
+ * @brief Data the screen can show, each updated by its own producer
+ */
+typedef enum {
+    DISPLAY_SOURCE_CLOCK,           // integer: local time, seconds since midnight
+    DISPLAY_SOURCE_TEMPERATURE,     // number: first sensor, degrees C
+    DISPLAY_SOURCE_WIFI,            // integer: RSSI in dBm, invalid while disconnected
+    DISPLAY_SOURCE_COUNT,
+} display_source_t;
+
+typedef struct {
+    bool valid;
+    int32_t integer;
+    float number;
+} display_value_t;
+
+/**
+ * @brief Latest value of every source plus a bit per source that changed
+ *        since the screen last rendered
+ */
+typedef struct {
+    display_value_t values[DISPLAY_SOURCE_COUNT];
+    uint32_t changed;
+} display_sources_t;
+
+/**
+ * @brief Turns a value into the widget's text
+ */
+typedef void (*display_format_t)(const display_value_t *value, char *text, size_t len);
+
+/**
+ * @brief One line of text bound to a source
+ */
+typedef struct {
+    int x;
+    int y;
+    const ssd1306_font_t *font;
+    display_source_t source;
+    display_format_t format;
+    char text[DISPLAY_WIDGET_TEXT_MAX];     // As currently drawn
+    int width;                              // Pixels covered by `text`
+    bool drawn;
+} display_widget_t;
+
+typedef struct {
+    display_widget_t widgets[DISPLAY_MAX_WIDGETS];
+    int count;
+} display_screen_t;
+
+/**
+ * @brief Request posted to the display's owner task
+ */
+typedef enum {
+    DISPLAY_CMD_TEXT,           // Clear the box, then draw one line of text
+    DISPLAY_CMD_FILL,           // Fill or clear a rectangle
+    DISPLAY_CMD_VALUE,          // New value for a source; widgets re-render on their own
+    DISPLAY_CMD_INVALIDATE,     // Resend a region even if it looks unchanged
+} display_cmd_type_t;
+
+typedef struct {
+    display_cmd_type_t type;
+    int16_t x;
+    int16_t y;
+    int16_t w;                  // TEXT: box cleared first, 0 = just the new text's width
+    int16_t h;                  // FILL/INVALIDATE only
+    union {
+        struct {
+            const ssd1306_font_t *font;
+            char text[DISPLAY_WIDGET_TEXT_MAX];
+        } text;
+        struct {
+            display_source_t source;
+            display_value_t value;
+        } update;
+        int color;              // FILL
+    };
+} display_cmd_t;
+
+static inline display_value_t display_value_integer(int32_t integer)
+{
+    return (display_value_t){ .valid = true, .integer = integer };
+}
+
+static inline display_value_t display_value_number(float number)
+{
+    return (display_value_t){ .valid = true, .number = number };
+}
+
+static inline display_value_t display_value_none(void)
+{
+    return (display_value_t){ .valid = false };
+}
+
+/**
+ * @brief Store a new value
+ * @return true if it differs from the previous one (the source is marked changed)
+ */
+bool display_sources_update(display_sources_t *sources, display_source_t source, display_value_t value);
+
+void display_screen_init(display_screen_t *screen);
+
+/**
+ * @brief Subscribe a text widget to a source
+ * @return Widget index, -1 if the screen is full
+ */
+int display_screen_add(display_screen_t *screen, int x, int y, const ssd1306_font_t *font,
+                       display_source_t source, display_format_t format);
+
+/**
+ * @brief Redraw the widgets of changed sources whose text is different
+ *
+ * Widgets that were never drawn are drawn regardless. The old text's area
+ * is cleared first, so a shorter text leaves nothing behind.
+ * @param changed Bit per source (sources->changed captured by the caller)
+ * @return Number of widgets redrawn
+ */
+int display_screen_render(display_screen_t *screen, const display_value_t values[DISPLAY_SOURCE_COUNT],
+                          uint32_t changed, ssd1306_fb_t *fb);
+
+/**
+ * @brief Execute one command in the owner task
+ * @return true if the framebuffer changed (TEXT, FILL, INVALIDATE)
+ */
+bool display_apply(const display_cmd_t *cmd, display_sources_t *sources, ssd1306_fb_t *fb);
+
+// Formatters for the built-in sources
+void display_format_clock(const display_value_t *value, char *text, size_t len);        // "12:34:56"
+void display_format_temperature(const display_value_t *value, char *text, size_t len);  // "Temp: 21.5 C"
+void display_format_wifi(const display_value_t *value, char *text, size_t len);         // "WiFi: -61 dBm"
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DISPLAY_MODEL_H
@@ -1,13 +1,45 @@
 #ifndef DS18B20_H
 #define DS18B20_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "driver/gpio.h"
+#include "driver/uart.h"
+#include "esp_err.h"
+#include "ds18b20_proto.h"
 
 // DS18B20 Configuration
 #define DS18B20_PIN GPIO_NUM_4  // Change this to your actual pin
-#define DS18B20_FAMILY_CODE 0x28
-#define DS18B20_RESOLUTION_12BIT 0x7F
+#define DS18B20_USE_UART_BUS 1      // 1 = UART-timed 1-Wire, 0 = GPIO bit-bang only
+#define DS18B20_UART_PORT UART_NUM_1
+#define DS18B20_RESOLUTION 12        // 9-12 bits, applied at init: 93.75/187.5/375/750 ms per conversion
+#define DS18B20_RETRY_DELAY_MS 1000  // Sensor task back-off when no sensor answers
+#define DS18B20_MAX_DEVICES 16       // Size of the device table filled by Search ROM
+#define DS18B20_READ_ATTEMPTS 3      // Scratchpad reads per sensor before giving up
+#define DS18B20_READ_BACKOFF_MS 10   // Delay before the first retry, doubled on each retry
+#define DS18B20_RESCAN_FAILURES 3    // Failed polls in a row on any sensor before the bus is searched again
+#define DS18B20_RESCAN_PERIOD_MS 60000  // Periodic Search ROM to pick up sensors added later
+
+/**
+ * @brief One sensor found on the bus
+ */
+typedef struct {
+    uint8_t rom[8];         // 64-bit ROM code (family, serial, CRC)
+    char name[24];          // Teleplot channel name, "ds18b20_<serial>"
+    uint8_t resolution;     // Configured resolution in bits (9-12)
+    float temperature;      // Last good reading in Celsius degrees
+    bool valid;             // Whether the last reading succeeded
+    uint32_t crc_errors;    // Scratchpad reads rejected by CRC or sanity check
+    uint32_t bus_errors;    // Reads where the sensor did not answer the reset pulse
+    uint32_t failed_reads;  // Readings dropped after all retries failed
+    uint32_t consecutive_failures;  // Polls in a row without a good reading
+} ds18b20_device_t;
+
+/**
+ * @brief Callback invoked from the esp_timer task when a conversion completes
+ */
+typedef void (*ds18b20_ready_cb_t)(void *arg);
 
 /**
  * @brief Initialize DS18B20 sensor
@@ -15,10 +47,83 @@
 void ds18b20_init(void);
 
 /**
- * @brief Read temperature from DS18B20 sensor
- * @return Temperature in Celsius degrees
+ * @brief Enumerate DS18B20 sensors with 1-Wire Search ROM
+ *
+ * Rebuilds the device table. Sensors that were already known keep their
+ * error counters and last reading; removed sensors drop out.
+ * @return Number of sensors stored in the device table
+ */
+size_t ds18b20_scan_bus(void);
+
+/**
+ * @brief Number of sensors found by the last ds18b20_scan_bus()
  */
-float ds18b20_read_temperature(void);
+size_t ds18b20_get_device_count(void);
+
+/**
+ * @brief Access a device table entry (ROM code, name and last reading)
+ * @return NULL if index is out of range
+ */
+const ds18b20_device_t *ds18b20_get_device(size_t index);
+
+/**
+ * @brief Start a temperature conversion on all sensors and return immediately
+ *
+ * Convert T is broadcast with Skip ROM, so every sensor converts in parallel.
+ * Completion is signalled by an esp_timer after the conversion time; the
+ * result is then fetched with ds18b20_poll().
+ * @return ESP_OK, ESP_ERR_NOT_FOUND if no sensor answered the reset pulse,
+ *         ESP_ERR_INVALID_STATE if a conversion is already running
+ */
+esp_err_t ds18b20_start_conversion(void);
+
+/**
+ * @brief Fetch the results of the conversion started by ds18b20_start_conversion()
+ *
+ * Reads every sensor's scratchpad with Match ROM and updates the device table.
+ * A read failing the CRC is retried up to DS18B20_READ_ATTEMPTS times with
+ * doubling back-off; a sensor whose reads all fail is marked invalid and
+ * keeps its last good temperature.
+ * @return ESP_OK if at least one sensor was read, ESP_ERR_NOT_FINISHED while
+ *         converting, ESP_ERR_INVALID_STATE if no conversion was started,
+ *         ESP_ERR_INVALID_CRC if sensors answered but no read passed the CRC,
+ *         ESP_ERR_NOT_FOUND if no sensor answered
+ */
+esp_err_t ds18b20_poll(void);
+
+/**
+ * @brief Set the resolution of every sensor in the device table
+ *
+ * Lower resolution shortens the conversion: 9 bits = 93.75 ms, 10 bits = 187.5 ms,
+ * 11 bits = 375 ms, 12 bits = 750 ms. The conversion wait follows automatically.
+ * @param bits Resolution, 9-12
+ * @param persist Also copy the configuration to EEPROM so it survives power-up
+ * @return ESP_OK, ESP_ERR_INVALID_ARG for an unsupported resolution,
+ *         ESP_ERR_INVALID_STATE while a conversion is running, or the first
+ *         sensor error (ESP_ERR_NOT_FOUND / ESP_ERR_INVALID_CRC / ESP_ERR_INVALID_RESPONSE
+ *         if the configuration did not read back)
+ */
+esp_err_t ds18b20_set_resolution(uint8_t bits, bool persist);
+
+/**
+ * @brief Current conversion wait in microseconds (slowest sensor on the bus)
+ */
+uint32_t ds18b20_get_conversion_time_us(void);
+
+/**
+ * @brief Register a callback fired when a conversion becomes ready
+ *
+ * Runs in the esp_timer task: keep it short (e.g. notify the reading task).
+ */
+void ds18b20_set_ready_callback(ds18b20_ready_cb_t cb, void *arg);
+
+/**
+ * @brief Read temperature from the first DS18B20 sensor (blocking wrapper)
+ * @param temperature Receives the temperature in Celsius degrees, untouched on error
+ * @return ESP_OK, the error from ds18b20_start_conversion()/ds18b20_poll(), or
+ *         ESP_ERR_INVALID_RESPONSE if only other sensors were read successfully
+ */
+esp_err_t ds18b20_read_temperature(float *temperature);
 
 /**
  * @brief Check if DS18B20 sensor is present on the bus
@@ -26,4 +131,9 @@ float ds18b20_read_temperature(void);
  */
 bool ds18b20_is_present(void);
 
+/**
+ * @brief Start the task that samples all sensors and publishes one Teleplot channel each
+ */
+void start_ds18b20_task(void);
+
 #endif // DS18B20_H
\ No newline at end of file
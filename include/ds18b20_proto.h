@@ -0,0 +1,102 @@
+#ifndef DS18B20_PROTO_H
+#define DS18B20_PROTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "onewire.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// DS18B20 function commands
+#define DS18B20_CMD_CONVERT_T        0x44
+#define DS18B20_CMD_READ_SCRATCHPAD  0xBE
+#define DS18B20_CMD_WRITE_SCRATCHPAD 0x4E
+#define DS18B20_CMD_COPY_SCRATCHPAD  0x48
+
+#define DS18B20_FAMILY_CODE          0x28
+#define DS18B20_SCRATCHPAD_SIZE      9
+
+// Configuration register bits 0-4 always read 1 and bit 7 reads 0
+#define DS18B20_CONFIG_FIXED_MASK    0x9F
+#define DS18B20_CONFIG_FIXED_BITS    0x1F
+
+// Resolution lives in configuration bits 5-6: 9 bits = 0x1F ... 12 bits = 0x7F
+#define DS18B20_RESOLUTION_MIN       9
+#define DS18B20_RESOLUTION_MAX       12
+#define DS18B20_CONFIG_FOR_RESOLUTION(bits) ((uint8_t)((((bits) - 9) << 5) | DS18B20_CONFIG_FIXED_BITS))
+
+#define DS18B20_EEPROM_WRITE_TIME_MS 10     // Copy Scratchpad duration (datasheet max)
+
+// Power-on scratchpad: 85.0 C with the reserved bytes at their reset values.
+// A sensor that browned out or was just plugged in reports it without converting.
+#define DS18B20_POWER_ON_RAW         0x0550
+#define DS18B20_RESERVED_5_RESET     0xFF
+#define DS18B20_RESERVED_7_RESET     0x10
+
+/**
+ * @brief Enumerate DS18B20 devices (valid ROM CRC and family code)
+ * @param roms Receives up to max_devices ROM codes
+ * @return Number of devices found
+ */
+size_t ds18b20_proto_search(onewire_bus_t *bus, uint8_t roms[][8], size_t max_devices);
+
+/**
+ * @brief Broadcast Convert T (Skip ROM) so every sensor converts in parallel
+ */
+onewire_status_t ds18b20_proto_convert_all(onewire_bus_t *bus);
+
+/**
+ * @brief Read one device's scratchpad with Match ROM
+ * @return ONEWIRE_ERR_CRC if the scratchpad CRC does not match, ONEWIRE_ERR_DATA if the
+ *         CRC passes but the configuration register is malformed or the scratchpad is
+ *         still the power-on value (data is still filled)
+ */
+onewire_status_t ds18b20_proto_read_scratchpad(onewire_bus_t *bus, const uint8_t rom[8],
+                                               uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE]);
+
+/**
+ * @brief Write the alarm thresholds and configuration register of one device
+ * @param rom Device to address, NULL for every device (Skip ROM)
+ */
+onewire_status_t ds18b20_proto_write_scratchpad(onewire_bus_t *bus, const uint8_t rom[8],
+                                                uint8_t th, uint8_t tl, uint8_t config);
+
+/**
+ * @brief Persist TH, TL and configuration to EEPROM
+ *
+ * The caller must leave the bus idle for DS18B20_EEPROM_WRITE_TIME_MS afterwards.
+ * @param rom Device to address, NULL for every device (Skip ROM)
+ */
+onewire_status_t ds18b20_proto_copy_scratchpad(onewire_bus_t *bus, const uint8_t rom[8]);
+
+/**
+ * @brief Whether a scratchpad still holds the power-on value (no conversion since reset)
+ *
+ * The configuration register is valid in such a scratchpad, only the temperature is not.
+ */
+bool ds18b20_proto_is_power_on(const uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE]);
+
+/**
+ * @brief Resolution in bits (9-12) encoded in a scratchpad's configuration register
+ */
+uint8_t ds18b20_proto_resolution(const uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE]);
+
+/**
+ * @brief Worst-case conversion time: 93.75, 187.5, 375 or 750 ms for 9-12 bits
+ */
+uint32_t ds18b20_proto_conversion_time_us(uint8_t resolution);
+
+/**
+ * @brief Temperature in Celsius degrees from a scratchpad
+ *
+ * Bits left undefined by lower resolutions are masked off.
+ */
+float ds18b20_proto_temperature(const uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // DS18B20_PROTO_H
@@ -6,5 +6,10 @@
 #define WIFI_SSID      "gear22"        // Zmień na nazwę swojej sieci WiFi
 #define WIFI_PASS      "czterymisie"       // Zmień na hasło swojej sieci WiFi
 
+// Opcjonalny adres statyczny zamiast DHCP (najszybszy start, adres spoza puli DHCP)
+//#define WIFI_STATIC_IP       "192.168.5.60"
+//#define WIFI_STATIC_NETMASK  "255.255.255.0"
+//#define WIFI_STATIC_GW       "192.168.5.1"
+
 
 #endif // HOST_IP_H
\ No newline at end of file
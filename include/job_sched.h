@@ -0,0 +1,103 @@
+#ifndef JOB_SCHED_H
+#define JOB_SCHED_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Maksymalna liczba zadań okresowych
+#define JOB_SCHED_MAX_JOBS  12
+
+typedef void (*job_fn_t)(void *arg);
+typedef int64_t (*job_clock_t)(void);   // Czas w µs (esp_timer_get_time())
+
+/**
+ * @brief Statystyki zadania od startu
+ *
+ * Jitter to odległość faktycznego startu od terminu (w obie strony - zadanie
+ * z zapasem może ruszyć wcześniej, żeby dzielić wybudzenie z innym).
+ */
+typedef struct {
+    uint32_t runs;
+    uint32_t skipped;           // Okresy pominięte, bo poprzednie wywołanie trwało za długo
+    uint32_t run_max_us;
+    uint64_t run_total_us;
+    uint32_t jitter_max_us;
+    uint64_t jitter_total_us;
+} job_stats_t;
+
+typedef struct {
+    const char *name;           // Napis o statycznym czasie życia
+    job_fn_t fn;
+    void *arg;
+    int64_t period_us;
+    int64_t slack_us;           // O tyle wcześniej może ruszyć, żeby dołączyć do innego wybudzenia
+    int64_t next_us;            // Najbliższy termin
+    atomic_bool enabled;        // Ustawiane z dowolnego wątku
+    bool active;                // Stan widziany przez planistę
+    job_stats_t stats;
+} job_t;
+
+/**
+ * @brief Kooperacyjny planista zadań okresowych
+ *
+ * Wszystkie zadania wykonują się po kolei na jednym stosie, więc nie mogą
+ * blokować - każde robi krótki krok i wraca. Terminy bliskie sobie (w granicach
+ * zapasu) są łączone w jedno wybudzenie.
+ *
+ * Wyzerowana struktura jest poprawnym, pustym planistą.
+ */
+typedef struct {
+    job_t jobs[JOB_SCHED_MAX_JOBS];
+    atomic_int count;
+    int64_t window_us;          // Wspólne okna wybudzeń, 0 = bez wyrównania
+    uint32_t wakeups;           // Przebiegi job_sched_run_due()
+} job_sched_t;
+
+/**
+ * @brief Dodaje zadanie, aktywne od razu (pierwsze wywołanie przy najbliższym przebiegu)
+ *
+ * Jeden dodający naraz - z wielu wątków trzeba wołać pod blokadą. Planista
+ * może w tym czasie działać.
+ * @return Identyfikator zadania albo -1, gdy brak miejsca
+ */
+int job_sched_add(job_sched_t *sched, const char *name, uint32_t period_ms, uint32_t slack_ms,
+                  job_fn_t fn, void *arg);
+
+/**
+ * @brief Wstrzymuje lub wznawia zadanie (z dowolnego wątku)
+ *
+ * Wstrzymane zadanie nie budzi planisty. Wznowione rusza przy najbliższym
+ * przebiegu, potem co okres - planistę trzeba obudzić, żeby to zauważył.
+ */
+void job_sched_set_enabled(job_sched_t *sched, int id, bool enabled);
+
+/**
+ * @brief Wyrównuje wybudzenia do wspólnej siatki okien
+ *
+ * Następny termin zwracany przez job_sched_run_due() jest zaokrąglany w górę
+ * do wielokrotności okna, więc wszystkie zadania z terminem w tym samym oknie
+ * ruszają w jednym wybudzeniu - kosztem spóźnienia mniejszego niż okno
+ * (widać je w jitterze). Wołać z wątku planisty albo przed jego startem.
+ */
+void job_sched_set_window(job_sched_t *sched, uint32_t window_ms);
+
+/**
+ * @brief Wykonuje wszystkie zadania, których termin (minus zapas) już minął
+ * @return Czas (µs) następnego terminu, INT64_MAX gdy nie ma aktywnych zadań
+ */
+int64_t job_sched_run_due(job_sched_t *sched, job_clock_t clock);
+
+static inline int job_sched_count(job_sched_t *sched) {
+    return atomic_load_explicit(&sched->count, memory_order_acquire);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // JOB_SCHED_H
@@ -0,0 +1,82 @@
+#ifndef ONEWIRE_H
+#define ONEWIRE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 1-Wire ROM commands
+#define ONEWIRE_CMD_SEARCH_ROM  0xF0
+#define ONEWIRE_CMD_MATCH_ROM   0x55
+#define ONEWIRE_CMD_SKIP_ROM    0xCC
+
+/**
+ * @brief Result of a 1-Wire transaction (portable, no ESP-IDF dependency)
+ */
+typedef enum {
+    ONEWIRE_OK = 0,
+    ONEWIRE_ERR_NO_PRESENCE,    // No device answered the reset pulse
+    ONEWIRE_ERR_CRC,            // Data received with a bad CRC8
+    ONEWIRE_ERR_DATA,           // CRC passed but the data is implausible (e.g. bus stuck low)
+} onewire_status_t;
+
+/**
+ * @brief 1-Wire transport: the only part that touches hardware
+ *
+ * Backends (GPIO bit-bang, UART, host fake) fill in the operations; the
+ * protocol layers above only talk to this interface.
+ */
+typedef struct onewire_bus {
+    bool (*reset)(struct onewire_bus *bus);                 // Reset pulse, returns presence
+    void (*write_bit)(struct onewire_bus *bus, int bit);
+    int (*read_bit)(struct onewire_bus *bus);
+    void (*write_bytes)(struct onewire_bus *bus, const uint8_t *data, size_t len);
+    void (*read_bytes)(struct onewire_bus *bus, uint8_t *data, size_t len);
+} onewire_bus_t;
+
+/**
+ * @brief Search ROM state carried between onewire_search_next() calls
+ *
+ * Zero-initialize before the first call.
+ */
+typedef struct {
+    uint8_t rom[8];
+    int last_discrepancy;
+    bool last_device;
+} onewire_search_t;
+
+/**
+ * @brief Dallas/Maxim CRC8 (polynomial x^8 + x^5 + x^4 + 1), table-driven
+ */
+uint8_t onewire_crc8(const uint8_t *data, size_t len);
+
+/**
+ * @brief Check the CRC byte of a 64-bit ROM code
+ */
+bool onewire_rom_valid(const uint8_t rom[8]);
+
+/**
+ * @brief One step of the Search ROM tree walk (Maxim AN187)
+ * @return true with the next ROM code in search->rom, false when done
+ */
+bool onewire_search_next(onewire_bus_t *bus, onewire_search_t *search);
+
+/**
+ * @brief Reset and address one device with Match ROM
+ */
+onewire_status_t onewire_match_rom(onewire_bus_t *bus, const uint8_t rom[8]);
+
+/**
+ * @brief Reset and address all devices with Skip ROM
+ */
+onewire_status_t onewire_skip_rom(onewire_bus_t *bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONEWIRE_H
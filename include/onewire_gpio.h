@@ -0,0 +1,31 @@
+#ifndef ONEWIRE_GPIO_H
+#define ONEWIRE_GPIO_H
+
+#include "driver/gpio.h"
+#include "onewire.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bit-banged 1-Wire transport (fallback backend)
+ *
+ * Every bit slot is timed with ets_delay_us, so the CPU is busy for ~70 us
+ * per bit.
+ */
+typedef struct {
+    onewire_bus_t bus;  // Must be first - the protocol layer sees only this
+    gpio_num_t pin;
+} onewire_gpio_t;
+
+/**
+ * @brief Configure the pin and fill in the transport operations
+ */
+void onewire_gpio_init(onewire_gpio_t *gpio, gpio_num_t pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONEWIRE_GPIO_H
@@ -0,0 +1,38 @@
+#ifndef ONEWIRE_UART_H
+#define ONEWIRE_UART_H
+
+#include "driver/gpio.h"
+#include "driver/uart.h"
+#include "esp_err.h"
+#include "onewire.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief UART-timed 1-Wire transport (Maxim AN214)
+ *
+ * TX and RX share the bus pin in open-drain mode. A reset is one 0xF0 byte
+ * at 9600 baud; every bit slot is one UART byte at 115200 baud (0xFF = write
+ * 1 / read slot, 0x00 = write 0) and is read back from the echo. Whole byte
+ * sequences are sent as one UART burst, so the CPU is free while the
+ * peripheral clocks the bits out.
+ */
+typedef struct {
+    onewire_bus_t bus;  // Must be first - the protocol layer sees only this
+    uart_port_t port;
+    gpio_num_t pin;
+} onewire_uart_t;
+
+/**
+ * @brief Install the UART driver on the bus pin and fill in the transport operations
+ * @return ESP_OK or the UART driver error (caller can fall back to onewire_gpio)
+ */
+esp_err_t onewire_uart_init(onewire_uart_t *uart, uart_port_t port, gpio_num_t pin);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONEWIRE_UART_H
@@ -0,0 +1,43 @@
+#ifndef POWER_MODE_H
+#define POWER_MODE_H
+
+#include "sdkconfig.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 1 = tryb oszczędny dla węzłów na baterii: automatyczny light sleep (tickless
+// idle), modem sleep WiFi z wybudzaniem co POWER_WIFI_LISTEN_INTERVAL beaconów,
+// wysyłanie telemetrii raz na taki okres i wspólne okna wybudzeń planisty.
+// 0 = jak dotąd: CPU i radio stale aktywne. Raport zużycia działa w obu trybach.
+#define POWER_LOW_POWER_MODE        0
+
+#define POWER_MAX_FREQ_MHZ          CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+#define POWER_MIN_FREQ_MHZ          CONFIG_XTAL_FREQ
+#define POWER_WAKE_WINDOW_MS        100     // Siatka wybudzeń planisty (sched_task.h)
+#define POWER_WIFI_LISTEN_INTERVAL  3       // Co ile beaconów (DTIM) radio się budzi
+#define POWER_BEACON_INTERVAL_MS    102     // Typowe 100 TU
+// Okres wysyłania telemetrii w trybie oszczędnym - radio i tak jest wtedy aktywne
+#define POWER_TX_PERIOD_MS          (POWER_WIFI_LISTEN_INTERVAL * POWER_BEACON_INTERVAL_MS)
+#define POWER_REPORT_PERIOD_MS      10000
+
+/**
+ * @brief Konfiguruje zarządzanie energią i dodaje zadanie raportu do planisty
+ *
+ * Wołać przed wifi_sta_start() i sched_start(). Raport co POWER_REPORT_PERIOD_MS
+ * loguje i publikuje do Teleplota (oba tryby mierzone tak samo):
+ * - power_awake_pct: udział czasu poza wątkiem IDLE, z liczników czasu FreeRTOS
+ *   (CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS); przybliżenie średniego prądu
+ * - power_ticks_s: przerwania ticka na sekundę, z haka ticka
+ * - power_wakeups_s: wyjścia z light sleep na sekundę (tylko w trybie
+ *   oszczędnym - bez niego nie ma czego liczyć)
+ * - wybudzenia planisty na sekundę (tylko log)
+ */
+void power_mode_init(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // POWER_MODE_H
@@ -0,0 +1,69 @@
+#ifndef PROFILER_STATS_H
+#define PROFILER_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PROFILER_MAX_TASKS      24
+#define PROFILER_TASK_NAME_MAX  16      // configMAX_TASK_NAME_LEN
+#define PROFILER_CHANNEL_MAX    32      // Mieści się w TELEPLOT_BIN_MAX_NAME
+
+/**
+ * @brief Stan jednego wątku między pomiarami
+ *
+ * Nazwy kanałów są budowane raz i nigdy się nie zmieniają - teleplot_publish()
+ * przechowuje tylko wskaźnik do nazwy.
+ */
+typedef struct {
+    char task[PROFILER_TASK_NAME_MAX];
+    char cpu_channel[PROFILER_CHANNEL_MAX];     // "sys.cpu.<wątek>"
+    char stack_channel[PROFILER_CHANNEL_MAX];   // "sys.stack.<wątek>"
+    uint32_t last_runtime;
+    bool primed;                // Jest poprzedni pomiar
+} profiler_task_t;
+
+/**
+ * @brief Profiler: zużycie CPU z różnic liczników czasu działania
+ *
+ * Liczniki są 32-bitowe i się przekręcają - różnice liczone są modulo 2^32.
+ * Wyzerowana struktura jest gotowa do użycia.
+ */
+typedef struct {
+    profiler_task_t tasks[PROFILER_MAX_TASKS];
+    int count;
+    uint32_t last_total;
+    bool primed;
+} profiler_t;
+
+/**
+ * @brief Rozpoczyna pomiar
+ * @param total Łączny licznik czasu (ulTotalRunTime z uxTaskGetSystemState())
+ * @return Przyrost łącznego czasu od poprzedniego pomiaru, 0 przy pierwszym
+ */
+uint32_t profiler_begin(profiler_t *prof, uint32_t total);
+
+/**
+ * @brief Wątek o danej nazwie; przy pierwszym wystąpieniu dostaje wpis na stałe
+ * @return NULL gdy zajęte są wszystkie PROFILER_MAX_TASKS wpisy
+ */
+profiler_task_t *profiler_task(profiler_t *prof, const char *name);
+
+/**
+ * @brief Zużycie CPU wątku od poprzedniego pomiaru
+ *
+ * @param runtime     Licznik czasu wątku (ulRunTimeCounter)
+ * @param total_delta Wynik profiler_begin()
+ * @param cores       Liczba rdzeni (łączny licznik liczy czas jednego rdzenia)
+ * @return Procent 0..100, ujemny gdy brak poprzedniego pomiaru
+ */
+float profiler_cpu_percent(profiler_task_t *task, uint32_t runtime, uint32_t total_delta, int cores);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PROFILER_STATS_H
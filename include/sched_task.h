@@ -0,0 +1,65 @@
+#ifndef SCHED_TASK_H
+#define SCHED_TASK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "job_sched.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SCHED_TASK_STACK_SIZE       4096    // Bajty - wspólny stos wszystkich zadań
+#define SCHED_TASK_PRIORITY         5
+#define SCHED_REPORT_PERIOD_MS      30000   // Co ile logować statystyki zadań
+
+/**
+ * @brief Rejestruje zadanie okresowe we wspólnym wątku planisty
+ *
+ * Zamiast osobnego wątku FreeRTOS (własny stos, własne wybudzenia) zadanie
+ * dostaje krótkie wywołania `fn` co `period_ms` na wspólnym stosie. Funkcja
+ * nie może blokować. `slack_ms` pozwala ruszyć do tylu ms wcześniej, żeby
+ * dzielić wybudzenie z innym zadaniem.
+ *
+ * Można wołać z dowolnego wątku, także przed sched_start().
+ * @return Identyfikator zadania albo -1
+ */
+int sched_add(const char *name, uint32_t period_ms, uint32_t slack_ms, job_fn_t fn, void *arg);
+
+/**
+ * @brief Wstrzymuje lub wznawia zadanie (z dowolnego wątku, nie z ISR)
+ *
+ * Wznowione zadanie rusza od razu.
+ */
+void sched_set_enabled(int id, bool enabled);
+
+/**
+ * @brief Wyrównuje wybudzenia planisty do wspólnych okien (0 = wyłączone)
+ *
+ * Wołać przed sched_start(). Patrz job_sched_set_window().
+ */
+void sched_set_window(uint32_t window_ms);
+
+/**
+ * @brief Liczba wybudzeń wątku planisty od startu
+ */
+uint32_t sched_get_wakeups(void);
+
+/**
+ * @brief Uruchamia wątek planisty
+ *
+ * Jeden wątek i jeden jednorazowy esp_timer ustawiany na najbliższy termin.
+ */
+void sched_start(void);
+
+/**
+ * @brief Statystyki zadania (kopia, do raportów z innych wątków)
+ * @return false dla nieznanego id
+ */
+bool sched_get_stats(int id, const char **name, job_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SCHED_TASK_H
@@ -0,0 +1,105 @@
+#ifndef SSD1306_CMD_H
+#define SSD1306_CMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// SSD1306 command definitions
+#define SSD1306_SET_CONTRAST_CTRL               0x81
+#define SSD1306_SET_ENTIRE_DISPLAY_ON_RESUME    0xA4
+#define SSD1306_SET_ENTIRE_DISPLAY_ON            0xA5
+#define SSD1306_SET_NORMAL_DISPLAY               0xA6
+#define SSD1306_SET_INVERSE_DISPLAY              0xA7
+#define SSD1306_SET_DISPLAY_OFF                  0xAE
+#define SSD1306_SET_DISPLAY_ON                   0xAF
+#define SSD1306_SET_DISPLAY_OFFSET               0xD3
+#define SSD1306_SET_COM_PINS_HW_CFG              0xDA
+#define SSD1306_SET_VCOM_DESELECT                0xDB
+#define SSD1306_SET_DISPLAY_CLK_DIV              0xD5
+#define SSD1306_SET_PRECHARGE                    0xD9
+#define SSD1306_SET_MULTIPLEX_RATIO              0xA8
+#define SSD1306_SET_LOW_COLUMN                   0x00
+#define SSD1306_SET_HIGH_COLUMN                  0x10
+#define SSD1306_SET_START_LINE                   0x40
+#define SSD1306_SET_MEMORY_ADDR_MODE             0x20
+#define SSD1306_SET_COLUMN_RANGE                 0x21
+#define SSD1306_SET_PAGE_RANGE                   0x22
+#define SSD1306_SET_COM_SCAN_DIR                 0xC0
+#define SSD1306_SET_COM_SCAN_DIR_OP              0xC8
+#define SSD1306_SET_SEGMENT_REMAP                0xA0
+#define SSD1306_SET_SEGMENT_REMAP_OP             0xA1
+#define SSD1306_SET_CHARGE_PUMP                  0x8D
+#define SSD1306_RIGHT_HORIZONTAL_SCROLL          0x26
+#define SSD1306_LEFT_HORIZONTAL_SCROLL           0x27
+#define SSD1306_CONTENT_SCROLL_RIGHT             0x2C    // SSD1306B/SSD1309/SSD1315 only
+#define SSD1306_CONTENT_SCROLL_LEFT              0x2D    // SSD1306B/SSD1309/SSD1315 only
+#define SSD1306_DEACTIVATE_SCROLL                0x2E
+#define SSD1306_ACTIVATE_SCROLL                  0x2F
+#define SSD1306_EXTERNAL_VCC                     0x1
+#define SSD1306_INTERNAL_VCC                     0x2
+
+// Consecutive content scroll steps must be at least two frames apart
+// (~107 Hz frame rate with the init table's clock divider)
+#define SSD1306_CONTENT_SCROLL_DELAY_MS          20
+
+// Control byte sent after the I2C address: Co = 0, so everything that
+// follows in the transaction is one command stream or one data stream
+#define SSD1306_CONTROL_CMD_STREAM               0x00
+#define SSD1306_CONTROL_DATA_STREAM              0x40
+
+/**
+ * @brief SSD1306 transport (I2C on the device, mock on the host)
+ *
+ * write() sends one transaction: the control byte followed by len bytes.
+ * Returns 0 on success. delay_ms() may be NULL where nothing needs to wait.
+ */
+typedef struct {
+    int (*write)(void *ctx, uint8_t control, const uint8_t *bytes, size_t len);
+    void (*delay_ms)(void *ctx, uint32_t ms);
+    void *ctx;
+} ssd1306_bus_t;
+
+/**
+ * @brief Send a command sequence in a single transaction
+ */
+int ssd1306_cmd_send(const ssd1306_bus_t *bus, const uint8_t *cmds, size_t len);
+
+/**
+ * @brief Send the power-up configuration table (128x64, charge pump, horizontal addressing)
+ */
+int ssd1306_cmd_init_panel(const ssd1306_bus_t *bus);
+
+/**
+ * @brief Restrict the following data stream to columns x0..x1 of pages page0..page1
+ */
+int ssd1306_cmd_set_window(const ssd1306_bus_t *bus, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1);
+
+/**
+ * @brief Move the panel RAM of pages page0..page1, columns x0..x1 one column left
+ *
+ * The column scrolled out re-enters on the right. Unlike the continuous
+ * scroll (0x26/0x27) this changes the RAM itself, so later writes land
+ * where expected. The caller must keep SSD1306_CONTENT_SCROLL_DELAY_MS
+ * between steps.
+ *
+ * Content scroll (0x2C/0x2D) is not in the original SSD1306 command set:
+ * only the SSD1306B, SSD1309 and SSD1315 controllers implement it. Others
+ * ignore the command and leave the RAM unchanged, so it must only be used
+ * when the fitted controller is known (SSD1306_CONTENT_SCROLL_ENABLE).
+ */
+int ssd1306_cmd_scroll_left(const ssd1306_bus_t *bus, uint8_t page0, uint8_t page1, uint8_t x0, uint8_t x1);
+
+/**
+ * @brief Show panel RAM row `line` (0..63) on the top row of the display
+ */
+int ssd1306_cmd_set_start_line(const ssd1306_bus_t *bus, uint8_t line);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_CMD_H
@@ -3,6 +3,9 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "display_model.h"
+#include "ssd1306_fb.h"
+#include "ssd1306_sparkline.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -14,17 +17,32 @@ extern "C" {
 #define SSD1306_SCL_GPIO        21 //GPIO_NUM_22
 #define SSD1306_I2C_FREQ_HZ     400000
 
-// Display dimensions
-#define SSD1306_WIDTH           128
-#define SSD1306_HEIGHT          64
+// Remote mirror of the screen over UDP (tools/fb_mirror.c), sent to HOST_IP
+#define SSD1306_SNAPSHOT_ENABLE             1
+#define SSD1306_SNAPSHOT_PORT               47271
+#define SSD1306_SNAPSHOT_MIN_INTERVAL_MS    1000
 
-// Function declarations
+// Display service: safe from any task, never block, false if the queue is full
+bool ssd1306_publish(display_source_t source, display_value_t value);
+bool ssd1306_post_text(int x, int y, int w, const char *text, const ssd1306_font_t *font);
+bool ssd1306_post_fill(int x, int y, int w, int h, int color);
+bool ssd1306_post_invalidate(int x, int y, int w, int h);
+uint32_t ssd1306_dropped_commands(void);
+void start_lcd_display_task(void);
+
+// Direct drawing into the back buffer: LCD task only (other tasks post commands)
 esp_err_t ssd1306_init(void);
 void ssd1306_clear_display(void);
-void ssd1306_display(void);
-void ssd1306_write_text(int x, int y, const char* text);
+void ssd1306_display(void);     // Swap: queue the drawn frame for the flush task, drawing may continue
+void ssd1306_wait_flush(void);  // Wait until the last swapped frame is on the panel
+void ssd1306_write_text(int x, int y, const char* text);                            // 8x8 font, wraps
+int ssd1306_draw_text(int x, int y, const char* text, const ssd1306_font_t *font);  // One line, returns end x
 void ssd1306_set_pixel(int x, int y, int color);
-void start_lcd_display_task(void);
+void ssd1306_draw_line(int x0, int y0, int x1, int y1, int color);
+void ssd1306_fill_rect(int x, int y, int w, int h, int color);
+void ssd1306_draw_sparkline(ssd1306_sparkline_t *chart);
+void ssd1306_scroll_left(int x, int y, int w, int h, int columns);  // Page-aligned: shifted by the panel if it can
+void ssd1306_scroll_up(int rows);                                   // Whole screen, via the start line
 
 #ifdef __cplusplus
 }
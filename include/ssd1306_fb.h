@@ -0,0 +1,186 @@
+#ifndef SSD1306_FB_H
+#define SSD1306_FB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ssd1306_cmd.h"
+#include "ssd1306_font.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Display dimensions
+#define SSD1306_WIDTH           128
+#define SSD1306_HEIGHT          64
+#define SSD1306_PAGES           (SSD1306_HEIGHT / 8)
+
+// Most hardware scroll steps worth waiting for in one flush; a longer
+// shift is cheaper to resend
+#define SSD1306_HW_SCROLL_MAX_STEPS     4
+
+// Set to 1 only for SSD1306B/SSD1309/SSD1315 panels: lets the flush shift
+// scrolled areas with the content scroll command. Off, scrolled columns
+// are resent like any other change.
+#ifndef SSD1306_CONTENT_SCROLL_ENABLE
+#define SSD1306_CONTENT_SCROLL_ENABLE   0
+#endif
+
+/**
+ * @brief Left shift of a page-aligned rectangle still to be done by the panel
+ */
+typedef struct {
+    uint8_t page0;
+    uint8_t page1;
+    uint8_t x0;
+    uint8_t x1;
+    uint8_t columns;    // 0 = nothing pending
+} ssd1306_fb_hscroll_t;
+
+/**
+ * @brief Framebuffer with per-page dirty column ranges
+ *
+ * Pixels are stored the way the panel expects them: one byte is 8 vertical
+ * pixels of a page, pages follow each other, 128 columns per page.
+ *
+ * The buffer always holds the picture as seen on the display. After
+ * ssd1306_fb_scroll_up() the panel shows it from RAM row `start_line`
+ * onwards; the flush maps rows accordingly.
+ */
+typedef struct {
+    uint8_t buffer[SSD1306_WIDTH * SSD1306_PAGES];
+    uint8_t shadow[SSD1306_WIDTH * SSD1306_PAGES];  // What the panel shows after the last flush, in buffer layout
+    uint8_t dirty_min[SSD1306_PAGES];               // First dirty column, SSD1306_WIDTH if the page is clean
+    uint8_t dirty_max[SSD1306_PAGES];               // Last dirty column
+    uint8_t stale_min[SSD1306_PAGES];               // Invalidated columns, resent even if unchanged
+    uint8_t stale_max[SSD1306_PAGES];
+    bool shadow_valid;                              // False until the first full flush
+    uint8_t start_line;                             // RAM row shown on top of the display
+    uint8_t panel_start_line;                       // Start line last sent to the panel
+    ssd1306_fb_hscroll_t hscroll;                   // Shift the next flush hands to the panel
+    bool content_scroll;                            // Panel has 0x2C/0x2D, SSD1306_CONTENT_SCROLL_ENABLE by default
+} ssd1306_fb_t;
+
+/**
+ * @brief Clear the framebuffer and mark the whole panel for the next flush
+ */
+void ssd1306_fb_init(ssd1306_fb_t *fb);
+
+/**
+ * @brief Clear the framebuffer (only pages that held pixels become dirty)
+ */
+void ssd1306_fb_clear(ssd1306_fb_t *fb);
+
+/**
+ * @brief Set or clear one pixel, ignoring coordinates outside the panel
+ */
+void ssd1306_fb_set_pixel(ssd1306_fb_t *fb, int x, int y, int color);
+
+/**
+ * @brief Fill (color != 0) or clear a rectangle, whole bytes per page
+ */
+void ssd1306_fb_fill_rect(ssd1306_fb_t *fb, int x, int y, int w, int h, int color);
+
+/**
+ * @brief Rectangle outline
+ */
+void ssd1306_fb_rect(ssd1306_fb_t *fb, int x, int y, int w, int h, int color);
+
+/**
+ * @brief Horizontal line from x0 to x1 inclusive: one masked byte per column
+ */
+void ssd1306_fb_hline(ssd1306_fb_t *fb, int x0, int x1, int y, int color);
+
+/**
+ * @brief Vertical line from y0 to y1 inclusive: one byte per page
+ */
+void ssd1306_fb_vline(ssd1306_fb_t *fb, int x, int y0, int y1, int color);
+
+/**
+ * @brief Bresenham line between two points, drawn as horizontal/vertical runs
+ */
+void ssd1306_fb_line(ssd1306_fb_t *fb, int x0, int y0, int x1, int y1, int color);
+
+/**
+ * @brief Move the contents of a rectangle left, clearing the vacated columns
+ *
+ * When the rectangle covers whole pages and the panel supports content
+ * scroll (fb->content_scroll), the next flush lets the panel do the shift,
+ * so only the vacated columns go over the bus. Otherwise the shifted
+ * columns are resent.
+ */
+void ssd1306_fb_scroll_left(ssd1306_fb_t *fb, int x, int y, int w, int h, int columns);
+
+/**
+ * @brief Scroll the whole picture up, clearing the rows that come in at the bottom
+ *
+ * The next flush moves the panel's start line instead of resending the
+ * picture: only the pages holding the new bottom rows are transmitted.
+ */
+void ssd1306_fb_scroll_up(ssd1306_fb_t *fb, int rows);
+
+/**
+ * @brief OR a column-major bitmap into the framebuffer
+ *
+ * The bitmap has `width` bytes per page, `pages` pages (bit 0 = top row).
+ * Page-aligned y costs one byte store per column; other y values split each
+ * column over two pages with a shift. Anything outside the panel is clipped.
+ */
+void ssd1306_fb_blit(ssd1306_fb_t *fb, int x, int y, const uint8_t *bitmap, int width, int pages);
+
+/**
+ * @brief Draw one character with a font
+ * @return Advance in pixels (0 if the font has no glyph for c)
+ */
+int ssd1306_fb_draw_char(ssd1306_fb_t *fb, int x, int y, char c, const ssd1306_font_t *font);
+
+/**
+ * @brief Draw a single line of text with a font, without wrapping
+ * @return x after the last glyph
+ */
+int ssd1306_fb_draw_text(ssd1306_fb_t *fb, int x, int y, const char *text, const ssd1306_font_t *font);
+
+/**
+ * @brief Draw text with the 8x8 font, wrapping at the right edge and on '\n'
+ */
+void ssd1306_fb_write_text(ssd1306_fb_t *fb, int x, int y, const char *text);
+
+/**
+ * @brief Mark columns x0..x1 of one page as changed
+ */
+void ssd1306_fb_mark_dirty(ssd1306_fb_t *fb, int page, int x0, int x1);
+
+/**
+ * @brief Resend a rectangle on the next flush even if the panel should already show it
+ *
+ * Covers whole pages vertically. Useful after the panel lost its RAM
+ * (brown-out, reset) or to repair a corrupted region.
+ */
+void ssd1306_fb_invalidate(ssd1306_fb_t *fb, int x, int y, int w, int h);
+
+/**
+ * @brief Copy a finished frame into another framebuffer (back to front buffer)
+ *
+ * The destination inherits the source's dirty ranges on top of its own, so a
+ * frame that failed to flush is still sent in full later. The source is left
+ * with its pixels and marked clean.
+ */
+void ssd1306_fb_copy_frame(ssd1306_fb_t *dst, ssd1306_fb_t *src);
+
+/**
+ * @brief Send the changed regions to the panel
+ *
+ * Pending scrolls are handed to the panel first (start line, content
+ * scroll if fb->content_scroll). Each dirty range is then trimmed against the panel's known
+ * contents, so redrawing identical pixels costs nothing. Every remaining
+ * page range is sent as a column/page window followed by just its bytes.
+ * @return 0 on success, otherwise the failing bus error (dirty state is kept for a retry)
+ */
+int ssd1306_fb_flush(ssd1306_fb_t *fb, const ssd1306_bus_t *bus);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_FB_H
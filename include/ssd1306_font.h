@@ -0,0 +1,75 @@
+#ifndef SSD1306_FONT_H
+#define SSD1306_FONT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Metrics of one glyph
+ *
+ * The bitmap holds only the ink columns: `width` bytes per page, pages one
+ * after another, bit 0 = top row.
+ */
+typedef struct {
+    uint16_t offset;    // Into the font's bitmap
+    uint8_t width;      // Ink columns, 0 for blank glyphs
+    uint8_t xoff;       // Left bearing inside the cell
+    uint8_t advance;    // Pen movement after the glyph, 0 if the glyph is missing
+} ssd1306_glyph_t;
+
+/**
+ * @brief Column-major font generated from tools/fonts by tools/gen_fonts.py
+ */
+typedef struct {
+    const uint8_t *bitmap;
+    const ssd1306_glyph_t *glyphs;  // One entry per code in first..last
+    uint8_t first;
+    uint8_t last;
+    uint8_t height;     // Pixels
+    uint8_t pages;      // Bytes per glyph column
+    uint8_t advance;    // Monospace cell width
+} ssd1306_font_t;
+
+// Generated tables (flash)
+extern const ssd1306_font_t ssd1306_font_5x7;           // Full ASCII, proportional
+extern const ssd1306_font_t ssd1306_font_8x8;           // Full ASCII, monospace
+extern const ssd1306_font_t ssd1306_font_16x24_digits;  // " +-.0123456789:C", proportional
+
+/**
+ * @brief Glyph for a character
+ * @return NULL if the font has no glyph for c
+ */
+static inline const ssd1306_glyph_t *ssd1306_font_glyph(const ssd1306_font_t *font, char c)
+{
+    uint8_t code = (uint8_t)c;
+    if (code < font->first || code > font->last) {
+        return NULL;
+    }
+    const ssd1306_glyph_t *glyph = &font->glyphs[code - font->first];
+    return glyph->advance ? glyph : NULL;
+}
+
+/**
+ * @brief Width in pixels of a single line of text
+ */
+static inline int ssd1306_font_text_width(const ssd1306_font_t *font, const char *text)
+{
+    int width = 0;
+    for (; *text; text++) {
+        const ssd1306_glyph_t *glyph = ssd1306_font_glyph(font, *text);
+        if (glyph) {
+            width += glyph->advance;
+        }
+    }
+    return width;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_FONT_H
@@ -0,0 +1,68 @@
+#ifndef SSD1306_SNAPSHOT_H
+#define SSD1306_SNAPSHOT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ssd1306_fb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Framebuffer snapshot datagram (multi-byte fields little-endian):
+ *
+ *   header:   'F' 'B' | version u8 | seq u16 | width u8 | height u8
+ *   payload:  run-length coded buffer bytes in panel layout (page by page,
+ *             column by column, bit 0 = top row of the page)
+ *
+ * Each run starts with a control byte c:
+ *   c < 0x80   c + 1 literal bytes follow
+ *   c >= 0x80  the next byte repeats c - 0x80 + 3 times
+ *
+ * A mostly blank 1 KB frame shrinks to a few dozen bytes; the worst case
+ * (no repeats at all) still fits one unfragmented datagram.
+ */
+
+#define SSD1306_SNAPSHOT_MAGIC0         'F'
+#define SSD1306_SNAPSHOT_MAGIC1         'B'
+#define SSD1306_SNAPSHOT_VERSION        1
+#define SSD1306_SNAPSHOT_HEADER_SIZE    7
+#define SSD1306_SNAPSHOT_FRAME_SIZE     (SSD1306_WIDTH * SSD1306_PAGES)
+#define SSD1306_SNAPSHOT_MAX_SIZE       (SSD1306_SNAPSHOT_HEADER_SIZE + SSD1306_SNAPSHOT_FRAME_SIZE + \
+                                         (SSD1306_SNAPSHOT_FRAME_SIZE + 127) / 128)
+
+// PBM (P4) image of a frame: text header plus one bit per pixel
+#define SSD1306_SNAPSHOT_PBM_SIZE       (16 + SSD1306_WIDTH / 8 * SSD1306_HEIGHT)
+
+/**
+ * @brief Encode a framebuffer's pixels into a datagram
+ * @return Datagram length, 0 if `size` is too small
+ */
+size_t ssd1306_snapshot_encode(const uint8_t *buffer, uint16_t seq, uint8_t *out, size_t size);
+
+/**
+ * @brief Decode a datagram back into a framebuffer's pixels
+ * @param buffer SSD1306_SNAPSHOT_FRAME_SIZE bytes
+ * @return 0 on success, -1 for a malformed or foreign datagram
+ */
+int ssd1306_snapshot_decode(const uint8_t *pkt, size_t len, uint8_t *buffer, uint16_t *seq);
+
+/**
+ * @brief Render a frame as a binary PBM image
+ *
+ * Lit pixels come out white on black, like on the panel.
+ * @return Image length, 0 if `size` is too small
+ */
+size_t ssd1306_snapshot_to_pbm(const uint8_t *buffer, uint8_t *out, size_t size);
+
+/**
+ * @brief FNV-1a hash of a frame, to tell whether it changed since the last snapshot
+ */
+uint32_t ssd1306_snapshot_hash(const uint8_t *buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_SNAPSHOT_H
@@ -0,0 +1,64 @@
+#ifndef SSD1306_SPARKLINE_H
+#define SSD1306_SPARKLINE_H
+
+#include <stdbool.h>
+#include "ssd1306_fb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SSD1306_SPARKLINE_MAX_SAMPLES   SSD1306_WIDTH   // One sample per column
+
+/**
+ * @brief Strip chart of the last `w` samples inside a framebuffer rectangle
+ *
+ * The newest sample is in the rightmost column. Each sample is joined to the
+ * previous one by a vertical run in its own column, so the trace stays
+ * connected however steep it is.
+ *
+ * Drawing is incremental: the rectangle is shifted left by the number of
+ * samples pushed since the last draw and only the new columns are drawn.
+ * The whole rectangle is redrawn only when the scale changes.
+ */
+typedef struct {
+    float samples[SSD1306_SPARKLINE_MAX_SAMPLES];   // Ring, `w` entries used
+    int head;           // Next slot to write
+    int count;          // Valid samples, up to w
+    int pending;        // Samples pushed since the last draw
+    int x, y, w, h;     // Rectangle on the panel
+    float min;          // Value drawn on the bottom row
+    float max;          // Value drawn on the top row
+    bool autoscale;     // Grow min/max to fit the samples
+    bool redraw;        // Scale changed, next draw repaints everything
+} ssd1306_sparkline_t;
+
+/**
+ * @brief Set up an empty chart
+ *
+ * Pass min == max to autoscale: the range then grows to fit the samples
+ * (it never shrinks, so a noisy signal does not repaint the chart each frame).
+ * The rectangle is clipped to the panel and to SSD1306_SPARKLINE_MAX_SAMPLES columns.
+ */
+void ssd1306_sparkline_init(ssd1306_sparkline_t *chart, int x, int y, int w, int h, float min, float max);
+
+/**
+ * @brief Append a sample, dropping the oldest one when the chart is full
+ */
+void ssd1306_sparkline_push(ssd1306_sparkline_t *chart, float value);
+
+/**
+ * @brief Bring the chart's rectangle in the framebuffer up to date
+ */
+void ssd1306_sparkline_draw(ssd1306_sparkline_t *chart, ssd1306_fb_t *fb);
+
+/**
+ * @brief Discard all samples; the next draw clears the rectangle
+ */
+void ssd1306_sparkline_reset(ssd1306_sparkline_t *chart);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SSD1306_SPARKLINE_H
@@ -0,0 +1,29 @@
+#ifndef SYS_PROFILER_H
+#define SYS_PROFILER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SYS_PROFILER_PERIOD_MS  5000
+
+/**
+ * @brief Dodaje do planisty zadanie profilera systemu
+ *
+ * Co SYS_PROFILER_PERIOD_MS publikuje do Teleplota:
+ * - sys.cpu.<wątek>   zużycie CPU w % od poprzedniego pomiaru
+ *                     (CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS)
+ * - sys.stack.<wątek> najmniejszy wolny zapas stosu w bajtach
+ *                     (CONFIG_FREERTOS_USE_TRACE_FACILITY)
+ * - sys.heap.free, sys.heap.min, sys.heap.largest - wolna sterta, jej minimum
+ *   od startu i największy wolny blok (fragmentacja)
+ *
+ * Najbardziej obciążający wątek (poza IDLE) trafia też do logu.
+ */
+void sys_profiler_start(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SYS_PROFILER_H
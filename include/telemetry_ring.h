@@ -0,0 +1,66 @@
+#ifndef TELEMETRY_RING_H
+#define TELEMETRY_RING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Liczba slotów bufora (musi być potęgą dwójki)
+#define TELEMETRY_RING_SIZE 128
+
+/**
+ * @brief Pojedyncza próbka telemetrii
+ *
+ * `name` musi wskazywać na napis o statycznym czasie życia (np. literał),
+ * bo do bufora trafia tylko wskaźnik.
+ */
+typedef struct {
+    const char *name;
+    float value;
+    int64_t timestamp_us;   // Czas powstania próbki (esp_timer_get_time())
+} telemetry_sample_t;
+
+typedef struct {
+    atomic_uint sequence;       // Numer sekwencyjny slotu (względem indeksu slotu)
+    telemetry_sample_t sample;
+} telemetry_slot_t;
+
+/**
+ * @brief Ograniczony, bezblokadowy bufor MPSC (wielu producentów, jeden konsument)
+ *
+ * Wyzerowana struktura jest poprawnym, pustym buforem - zmienna statyczna nie
+ * wymaga inicjalizacji, więc producenci mogą publikować zanim ruszy konsument.
+ */
+typedef struct {
+    telemetry_slot_t slots[TELEMETRY_RING_SIZE];
+    atomic_uint head;           // Następna pozycja do zapisu (producenci)
+    atomic_uint tail;           // Następna pozycja do odczytu (konsument)
+    atomic_uint dropped;        // Próbki odrzucone z powodu przepełnienia
+} telemetry_ring_t;
+
+/**
+ * @brief Dodaje próbkę do bufora w czasie O(1), nigdy nie blokuje
+ * @return false gdy bufor jest pełny (próbka odrzucona, licznik dropped++)
+ */
+bool telemetry_ring_push(telemetry_ring_t *ring, const telemetry_sample_t *sample);
+
+/**
+ * @brief Pobiera najstarszą próbkę; wolno wołać tylko z jednego wątku
+ * @return false gdy bufor jest pusty
+ */
+bool telemetry_ring_pop(telemetry_ring_t *ring, telemetry_sample_t *out);
+
+/**
+ * @brief Zwraca łączną liczbę odrzuconych próbek
+ */
+uint32_t telemetry_ring_dropped(const telemetry_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TELEMETRY_RING_H
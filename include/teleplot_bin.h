@@ -0,0 +1,130 @@
+#ifndef TELEPLOT_BIN_H
+#define TELEPLOT_BIN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Binarny protokół telemetrii (wszystkie pola little-endian):
+ *
+ *   nagłówek:  'T' 'B' | wersja u8 | typ u8 | seq u16
+ *   DICT:      count u8 | count x { id u8 | typ u8 | decimals u8 | len u8 | nazwa }
+ *   DATA:      base_ms u32 | count u8 | count x { id u8 | dt i16 | wartość }
+ *
+ * Wartość to float32 (TELEPLOT_BIN_F32) albo int16 przeskalowany o 10^decimals
+ * (TELEPLOT_BIN_I16). Nazwy kanałów są wysyłane tylko w pakietach DICT.
+ * Czas próbki = base_ms * 1000 + dt * TELEPLOT_BIN_DT_UNIT_US [µs od startu urządzenia].
+ */
+
+#define TELEPLOT_BIN_MAGIC0          'T'
+#define TELEPLOT_BIN_MAGIC1          'B'
+#define TELEPLOT_BIN_VERSION         2
+#define TELEPLOT_BIN_HEADER_SIZE     6
+#define TELEPLOT_BIN_MAX_CHANNELS    64
+#define TELEPLOT_BIN_MAX_NAME        31
+#define TELEPLOT_BIN_DT_UNIT_US      100   // Rozdzielczość czasu próbki (zakres dt: ±3.2 s)
+#define TELEPLOT_BIN_MAX_SAMPLES     255   // Pole count pakietu DATA to u8
+
+// Najdłuższa linia tekstu jednej próbki: nazwa ':' czas ':' wartość "|g".
+// Czas to u32 ms z trzema miejscami (14 znaków), wartość to co najwyżej
+// 20 cyfr, kropka i znak (teleplot_format_fixed odrzuca większe)
+#define TELEPLOT_BIN_MAX_LINE        (TELEPLOT_BIN_MAX_NAME + 1 + 14 + 1 + 22 + 2)
+// Bufor tekstu, w który zawsze mieści się zdekodowany pakiet DATA (z '\n')
+#define TELEPLOT_BIN_MAX_TEXT        (TELEPLOT_BIN_MAX_SAMPLES * (TELEPLOT_BIN_MAX_LINE + 1))
+
+// Typy pakietów
+#define TELEPLOT_BIN_PKT_DICT        1
+#define TELEPLOT_BIN_PKT_DATA        2
+
+// Typy wartości kanału
+#define TELEPLOT_BIN_F32             0
+#define TELEPLOT_BIN_I16             1
+
+typedef struct {
+    char name[TELEPLOT_BIN_MAX_NAME + 1];
+    uint8_t type;       // TELEPLOT_BIN_F32 / TELEPLOT_BIN_I16
+    uint8_t decimals;   // Dla I16: wartość = raw / 10^decimals; dla F32: precyzja tekstu
+} teleplot_bin_channel_t;
+
+/**
+ * @brief Słownik kanałów - wspólny dla kodera (urządzenie) i dekodera (mostek)
+ */
+typedef struct {
+    teleplot_bin_channel_t channels[TELEPLOT_BIN_MAX_CHANNELS];
+    bool known[TELEPLOT_BIN_MAX_CHANNELS];  // Dekoder: czy id zostało już opisane przez DICT
+    uint8_t count;                          // Koder: liczba zarejestrowanych kanałów
+    uint16_t seq;                           // Koder: numer kolejnego pakietu
+    uint32_t unknown_samples;               // Dekoder: próbki z nieznanym id (brak DICT)
+    uint32_t skipped_samples;               // Dekoder: wartości, których nie da się zapisać tekstem
+} teleplot_bin_dict_t;
+
+/**
+ * @brief Pakiet DATA w trakcie składania
+ */
+typedef struct {
+    uint8_t *buf;
+    size_t size;
+    size_t len;
+    uint8_t count;
+    int64_t base_us;    // Czas bazowy pakietu (ustalany przez pierwszą próbkę)
+} teleplot_bin_frame_t;
+
+/**
+ * @brief Zwraca id kanału, rejestrując go (jako F32) przy pierwszym użyciu
+ * @param added Ustawiane na true gdy kanał został właśnie dodany (może być NULL)
+ * @return id kanału lub -1 gdy słownik jest pełny / nazwa za długa
+ */
+int teleplot_bin_channel_id(teleplot_bin_dict_t *dict, const char *name, bool *added);
+
+/**
+ * @brief Rejestruje kanał z jawnym typem wartości
+ * @return id kanału lub -1
+ */
+int teleplot_bin_register(teleplot_bin_dict_t *dict, const char *name,
+                          uint8_t type, uint8_t decimals);
+
+/**
+ * @brief Zapisuje pakiet DICT z kanałami od *next; *next wskazuje pierwszy niezapisany
+ *
+ * Duży słownik może wymagać kilku pakietów - wołaj aż *next == dict->count.
+ * @return Długość pakietu lub 0 gdy nic się nie zmieściło
+ */
+size_t teleplot_bin_write_dict(teleplot_bin_dict_t *dict, uint8_t *buf, size_t size,
+                               uint8_t *next);
+
+/**
+ * @brief Rozpoczyna pakiet DATA w buforze
+ */
+void teleplot_bin_frame_begin(teleplot_bin_dict_t *dict, teleplot_bin_frame_t *frame,
+                              uint8_t *buf, size_t size);
+
+/**
+ * @brief Dopisuje próbkę z jej czasem powstania do pakietu DATA
+ * @return false gdy próbka się nie mieści lub jej czas wykracza poza zakres dt
+ *         (pakiet trzeba wysłać i zacząć nowy)
+ */
+bool teleplot_bin_frame_add(const teleplot_bin_dict_t *dict, teleplot_bin_frame_t *frame,
+                            uint8_t id, int64_t timestamp_us, float value);
+
+/**
+ * @brief Dekoduje pakiet do tekstowego formatu Teleplot ("nazwa:czas_ms:wartość|g", linie '\n')
+ *
+ * Pakiety DICT aktualizują słownik dekodera i nie produkują tekstu.
+ * Próbka z wartością poza zakresem formattera (np. 1e30 przy 3 miejscach)
+ * jest pomijana i liczona w skipped_samples - reszta pakietu przechodzi.
+ * Bufor TELEPLOT_BIN_MAX_TEXT zawsze wystarcza.
+ * @return Długość tekstu (0 dla DICT) lub -1 dla błędnego pakietu / za małego bufora
+ */
+int teleplot_bin_decode(teleplot_bin_dict_t *dict, const uint8_t *pkt, size_t len,
+                        char *out, size_t out_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TELEPLOT_BIN_H
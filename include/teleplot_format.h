@@ -0,0 +1,67 @@
+#ifndef TELEPLOT_FORMAT_H
+#define TELEPLOT_FORMAT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Maksymalna liczba miejsc po przecinku obsługiwana przez formatter
+#define TELEPLOT_FORMAT_MAX_DECIMALS 9
+
+/**
+ * @brief Formatuje liczbę stałoprzecinkowo, bajt w bajt jak snprintf("%.*f")
+ *
+ * Nie używa printf ani sterty, jest reentrantny. Zaokrągla do najbliższej
+ * (połówki do parzystej), tak jak newlib/glibc. Nie dopisuje '\0'.
+ *
+ * @param buf      Bufor docelowy (np. bezpośrednio datagram)
+ * @param size     Dostępne miejsce w buforze
+ * @param value    Wartość do sformatowania
+ * @param decimals Liczba miejsc po przecinku (0..TELEPLOT_FORMAT_MAX_DECIMALS)
+ * @return Liczba zapisanych bajtów lub -1 gdy brak miejsca / wartość poza zakresem
+ */
+int teleplot_format_fixed(char *buf, size_t size, float value, int decimals);
+
+/**
+ * @brief Formatuje linię Teleplot "nazwa:wartość|g" bez printf
+ *
+ * Nie dopisuje '\0' - przeznaczone do składania datagramu w miejscu.
+ *
+ * @return Liczba zapisanych bajtów lub -1 gdy linia się nie mieści
+ */
+int teleplot_format_metric(char *buf, size_t size, const char *name,
+                           float value, int decimals);
+
+/**
+ * @brief Formatuje linię Teleplot ze znacznikiem czasu "nazwa:czas_ms:wartość|g"
+ *
+ * Czas jest zapisywany w milisekundach z trzema miejscami po przecinku
+ * (rozdzielczość 1 µs). Nie dopisuje '\0'.
+ *
+ * @param timestamp_us Czas powstania próbki w µs (np. esp_timer_get_time())
+ * @return Liczba zapisanych bajtów lub -1 gdy linia się nie mieści
+ */
+int teleplot_format_metric_at(char *buf, size_t size, const char *name,
+                              int64_t timestamp_us, float value, int decimals);
+
+/**
+ * @brief Dopisuje linię ze znacznikiem czasu do składanego datagramu
+ *
+ * Linie są oddzielone '\n' (pierwsza bez separatora). Bufor może być
+ * zapełniony co do bajtu - wtedy każda kolejna linia zwraca false.
+ *
+ * @param len Zajęte bajty w buf, zwiększane o separator i linię
+ * @return false gdy linia się nie mieści - buf i *len bez zmian
+ */
+bool teleplot_format_append_at(char *buf, size_t size, size_t *len, const char *name,
+                               int64_t timestamp_us, float value, int decimals);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TELEPLOT_FORMAT_H
@@ -1,28 +1,72 @@
 #ifndef TELEPLOT_UDP_H
 #define TELEPLOT_UDP_H
 
+#include <stdbool.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 /**
- * @brief Uruchamia wątek wysyłający dane UDP do programu Teleplot
+ * @brief Uruchamia wysyłanie danych UDP do programu Teleplot
  * 
- * Funkcja tworzy nowy wątek, który co 100ms wysyła przykładowe dane
- * do programu Teleplot przez UDP. Dane zawierają:
+ * Funkcja dodaje do planisty (sched_task.h) zadanie wysyłające (opróżnia bufor
+ * teleplot_publish() i wysyła próbki przez UDP) oraz zadanie, które co 100ms
+ * publikuje przykładowe dane:
  * - Funkcje sinusoidalne (sinus, cosinus)
  * - Dane losowe
  * - Symulację temperatury
  * - Licznik danych
+ *
+ * Próbki są łączone w jeden datagram (linie "nazwa:czas_ms:wartość|g" oddzielone
+ * znakiem '\n'), wysyłany gdy bufor się zapełni lub minie termin
+ * TELEPLOT_BATCH_DEADLINE_MS od dopisania pierwszej próbki.
  * 
- * Przed wywołaniem tej funkcji upewnij się, że WiFi jest połączone.
+ * Wymaga wcześniejszego wifi_sta_start(), ale nie połączenia: bez sieci
+ * zadanie wysyłające jest wstrzymane, a próbki czekają w buforze (do TELEMETRY_RING_SIZE).
+ * Wysyłanie rusza w chwili uzyskania adresu IP.
  * 
  * Konfiguracja:
  * - Zmień TELEPLOT_IP w teleplot_udp.c na IP Twojego komputera
  * - Domyślny port: 47269
+ * - TELEPLOT_BINARY_MODE = 1 w teleplot_udp.c włącza kompaktowy protokół binarny
+ *   (teleplot_bin.h) wysyłany na port 47270; na komputerze uruchom
+ *   tools/teleplot_bridge.c, który przekazuje dane do Teleplota jako tekst
  */
 void start_teleplot_udp_task(void);
 
+/**
+ * @brief Publikuje próbkę do wysłania przez Teleplot (z dowolnego wątku)
+ *
+ * Czas próbki (esp_timer_get_time()) jest zapisywany w chwili wywołania, nie
+ * wysłania, więc buforowanie nie zniekształca osi czasu w Teleplocie.
+ * Próbka trafia do bezblokadowego bufora w czasie O(1); socketem zajmuje się
+ * wyłącznie zadanie wysyłające, więc producent nigdy nie czeka na WiFi.
+ *
+ * @param name  Nazwa kanału - musi być napisem o statycznym czasie życia
+ * @param value Wartość próbki
+ * @return false gdy bufor był pełny i próbka została odrzucona
+ */
+bool teleplot_publish(const char *name, float value);
+
+/**
+ * @brief Publikuje próbkę z jawnym czasem powstania
+ *
+ * Dla pomiarów, których moment jest znany wcześniej niż wynik (np. start
+ * konwersji czujnika). Czas trafia do Teleplota jako "nazwa:czas_ms:wartość|g".
+ *
+ * @param timestamp_us Czas powstania próbki w µs (esp_timer_get_time())
+ */
+bool teleplot_publish_at(const char *name, float value, int64_t timestamp_us);
+
+/**
+ * @brief Zwraca liczbę próbek odrzuconych z powodu przepełnienia bufora
+ *
+ * Ta sama wartość jest wysyłana jako kanał "teleplot_dropped" przy każdej zmianie.
+ */
+uint32_t teleplot_get_dropped_count(void);
+
 #ifdef __cplusplus
 }
 #endif
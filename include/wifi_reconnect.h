@@ -0,0 +1,80 @@
+#ifndef WIFI_RECONNECT_H
+#define WIFI_RECONNECT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Opóźnienie ponownej próby: od WIFI_BACKOFF_MIN_MS, podwajane po każdej
+// porażce, z górnym limitem WIFI_BACKOFF_MAX_MS
+#define WIFI_BACKOFF_MIN_MS         250
+#define WIFI_BACKOFF_MAX_MS         60000
+
+// Tyle prób szybkiego połączenia (zapamiętany BSSID i kanał) przed powrotem
+// do pełnego skanowania - AP mógł zmienić kanał albo zniknąć
+#define WIFI_FAST_CONNECT_ATTEMPTS  2
+
+#define WIFI_CACHE_VERSION          1
+
+/**
+ * @brief Ostatni dobry punkt dostępowy, zapisywany w NVS
+ *
+ * Zapis jest ważny tylko dla sieci, w której powstał - zmiana WIFI_SSID
+ * w host_ip.h unieważnia go bez kasowania NVS.
+ */
+typedef struct {
+    uint8_t version;
+    uint8_t channel;
+    uint8_t bssid[6];
+    char ssid[33];
+} wifi_cache_t;
+
+typedef enum {
+    WIFI_CONNECT_FAST,      // Bezpośrednio do zapamiętanego BSSID na jego kanale
+    WIFI_CONNECT_SCAN,      // Pełne skanowanie, najsilniejszy AP o danym SSID
+} wifi_connect_mode_t;
+
+/**
+ * @brief Stan ponownego łączenia - próby nigdy się nie kończą
+ */
+typedef struct {
+    uint32_t failures;      // Nieudane próby od ostatniego połączenia
+    bool cache_valid;       // Jest zapamiętany AP dla tej sieci
+} wifi_reconnect_t;
+
+/**
+ * @brief Sprawdza, czy zapis z NVS pasuje do bieżącej wersji i sieci
+ */
+bool wifi_cache_valid(const wifi_cache_t *cache, const char *ssid);
+
+void wifi_reconnect_init(wifi_reconnect_t *rc, bool cache_valid);
+
+/**
+ * @brief Sposób łączenia dla następnej próby
+ */
+wifi_connect_mode_t wifi_reconnect_mode(const wifi_reconnect_t *rc);
+
+/**
+ * @brief Rejestruje nieudaną próbę
+ *
+ * Opóźnienie losowane jest z przedziału [d/2, d] ("equal jitter"), żeby
+ * urządzenia po zaniku zasilania nie łączyły się wszystkie naraz.
+ *
+ * @param random Dowolna liczba losowa (esp_random())
+ * @return Opóźnienie następnej próby w ms
+ */
+uint32_t wifi_reconnect_failed(wifi_reconnect_t *rc, uint32_t random);
+
+/**
+ * @brief Rejestruje udane połączenie; AP zostaje zapamiętany
+ */
+void wifi_reconnect_connected(wifi_reconnect_t *rc);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WIFI_RECONNECT_H
@@ -0,0 +1,81 @@
+#ifndef WIFI_STA_H
+#define WIFI_STA_H
+
+#include <stdbool.h>
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Maksymalna liczba obserwatorów stanu połączenia
+#define WIFI_STA_MAX_LISTENERS  4
+
+/**
+ * @brief Obserwator stanu połączenia
+ *
+ * Wywoływany z wątku pętli zdarzeń tylko przy zmianie stanu: po uzyskaniu
+ * adresu IP (connected = true, rssi w dBm) i po jego utracie. Nie może
+ * blokować - zwykle ustawia flagę, publikuje wartość albo wysyła powiadomienie.
+ */
+typedef void (*wifi_sta_listener_t)(bool connected, int rssi, void *arg);
+
+/**
+ * @brief Uruchamia WiFi w trybie stacji i od razu wraca
+ *
+ * Pierwsza próba idzie bezpośrednio do AP zapamiętanego w NVS (BSSID + kanał,
+ * bez skanowania), adres IP odnawiany jest z ostatniej dzierżawy DHCP
+ * (CONFIG_LWIP_DHCP_RESTORE_LAST_IP) albo ustawiany statycznie, gdy
+ * w host_ip.h zdefiniowano WIFI_STATIC_IP. Po rozłączeniu próby powtarzane
+ * są bez końca z wykładniczo rosnącym opóźnieniem (wifi_reconnect.h).
+ *
+ * Czas od resetu do uzyskania adresu (pierwszy pakiet może już wyjść) jest
+ * logowany i publikowany jako kanał Teleplot "wifi_connect_ms".
+ *
+ * Wymaga zainicjalizowanego NVS. Funkcje poniżej można wołać dopiero po
+ * wifi_sta_start().
+ */
+void wifi_sta_start(void);
+
+/**
+ * @brief Rejestruje obserwatora stanu połączenia
+ *
+ * Rejestracja przed wifi_sta_start() gwarantuje, że obserwator zobaczy
+ * pierwsze połączenie.
+ * @return false gdy zajęte są wszystkie WIFI_STA_MAX_LISTENERS miejsca
+ */
+bool wifi_sta_subscribe(wifi_sta_listener_t listener, void *arg);
+
+/**
+ * @brief Czy stacja ma teraz adres IP (nie blokuje)
+ */
+bool wifi_sta_is_connected(void);
+
+/**
+ * @brief Bieżąca siła sygnału AP (nie blokuje)
+ *
+ * Obserwatorzy dostają RSSI tylko przy zmianie stanu; wartość na bieżąco
+ * trzeba odczytywać okresowo.
+ * @return false bez połączenia - *rssi nie jest zmieniane
+ */
+bool wifi_sta_get_rssi(int *rssi);
+
+/**
+ * @brief Czeka na połączenie z adresem IP
+ *
+ * Wraca natychmiast po IP_EVENT_STA_GOT_IP - bez odpytywania.
+ * @return false po upływie czasu - łączenie trwa dalej w tle
+ */
+bool wifi_sta_wait_connected(TickType_t timeout);
+
+/**
+ * @brief Czeka na utratę połączenia
+ * @return false po upływie czasu, gdy połączenie nadal jest
+ */
+bool wifi_sta_wait_disconnected(TickType_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WIFI_STA_H
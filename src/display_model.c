@@ -0,0 +1,124 @@
+#include "display_model.h"
+
+#include <stdio.h>
+#include <string.h>
+
+bool display_sources_update(display_sources_t *sources, display_source_t source, display_value_t value)
+{
+    if (source >= DISPLAY_SOURCE_COUNT) {
+        return false;
+    }
+
+    display_value_t *current = &sources->values[source];
+    bool same = current->valid == value.valid &&
+                (!value.valid || (current->integer == value.integer && current->number == value.number));
+    if (same) {
+        return false;
+    }
+    *current = value;
+    sources->changed |= 1u << source;
+    return true;
+}
+
+void display_screen_init(display_screen_t *screen)
+{
+    memset(screen, 0, sizeof(*screen));
+}
+
+int display_screen_add(display_screen_t *screen, int x, int y, const ssd1306_font_t *font,
+                       display_source_t source, display_format_t format)
+{
+    if (screen->count >= DISPLAY_MAX_WIDGETS || source >= DISPLAY_SOURCE_COUNT) {
+        return -1;
+    }
+
+    display_widget_t *widget = &screen->widgets[screen->count];
+    memset(widget, 0, sizeof(*widget));
+    widget->x = x;
+    widget->y = y;
+    widget->font = font;
+    widget->source = source;
+    widget->format = format;
+    return screen->count++;
+}
+
+int display_screen_render(display_screen_t *screen, const display_value_t values[DISPLAY_SOURCE_COUNT],
+                          uint32_t changed, ssd1306_fb_t *fb)
+{
+    int redrawn = 0;
+
+    for (int i = 0; i < screen->count; i++) {
+        display_widget_t *widget = &screen->widgets[i];
+        if (widget->drawn && !(changed & (1u << widget->source))) {
+            continue;
+        }
+
+        // A new value often formats to the same text (clock source vs. a
+        // widget showing minutes, temperature below display precision)
+        char text[DISPLAY_WIDGET_TEXT_MAX];
+        widget->format(&values[widget->source], text, sizeof(text));
+        if (widget->drawn && strcmp(text, widget->text) == 0) {
+            continue;
+        }
+
+        if (widget->drawn) {
+            ssd1306_fb_fill_rect(fb, widget->x, widget->y, widget->width, widget->font->height, 0);
+        }
+        widget->width = ssd1306_fb_draw_text(fb, widget->x, widget->y, text, widget->font) - widget->x;
+        strcpy(widget->text, text);
+        widget->drawn = true;
+        redrawn++;
+    }
+    return redrawn;
+}
+
+bool display_apply(const display_cmd_t *cmd, display_sources_t *sources, ssd1306_fb_t *fb)
+{
+    switch (cmd->type) {
+    case DISPLAY_CMD_TEXT: {
+        const ssd1306_font_t *font = cmd->text.font;
+        int width = ssd1306_font_text_width(font, cmd->text.text);
+        ssd1306_fb_fill_rect(fb, cmd->x, cmd->y, cmd->w > width ? cmd->w : width, font->height, 0);
+        ssd1306_fb_draw_text(fb, cmd->x, cmd->y, cmd->text.text, font);
+        return true;
+    }
+    case DISPLAY_CMD_FILL:
+        ssd1306_fb_fill_rect(fb, cmd->x, cmd->y, cmd->w, cmd->h, cmd->color);
+        return true;
+    case DISPLAY_CMD_VALUE:
+        display_sources_update(sources, cmd->update.source, cmd->update.value);
+        return false;
+    case DISPLAY_CMD_INVALIDATE:
+        ssd1306_fb_invalidate(fb, cmd->x, cmd->y, cmd->w, cmd->h);
+        return true;
+    }
+    return false;
+}
+
+void display_format_clock(const display_value_t *value, char *text, size_t len)
+{
+    if (!value->valid) {
+        snprintf(text, len, "--:--:--");
+        return;
+    }
+    int32_t seconds = value->integer;
+    snprintf(text, len, "%02d:%02d:%02d", (int)(seconds / 3600 % 24), (int)(seconds / 60 % 60), (int)(seconds % 60));
+}
+
+void display_format_temperature(const display_value_t *value, char *text, size_t len)
+{
+    if (!value->valid) {
+        snprintf(text, len, "Temp: --");
+        return;
+    }
+    snprintf(text, len, "Temp: %.1f C", value->number);
+}
+
+void display_format_wifi(const display_value_t *value, char *text, size_t len)
+{
+    if (!value->valid) {
+        snprintf(text, len, "WiFi: down");
+        return;
+    }
+    snprintf(text, len, "WiFi: %d dBm", (int)value->integer);
+}
@@ -1,142 +1,399 @@
 #include "ds18b20.h"
 #include "esp_log.h"
-#include "rom/ets_sys.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "onewire_gpio.h"
+#include "onewire_uart.h"
+#include "teleplot_udp.h"
+#include "ssd1306_display.h"
 #include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
 
 static const char *DS18B20_TAG = "DS18B20";
 
-// OneWire low-level functions
-static void onewire_reset(void) {
-    gpio_set_direction(DS18B20_PIN, GPIO_MODE_OUTPUT);
-    gpio_set_level(DS18B20_PIN, 0);
-    ets_delay_us(480);
-    gpio_set_level(DS18B20_PIN, 1);
-    ets_delay_us(70);
-    gpio_set_direction(DS18B20_PIN, GPIO_MODE_INPUT);
-    ets_delay_us(410);
-}
-
-static bool onewire_presence_pulse(void) {
-    gpio_set_direction(DS18B20_PIN, GPIO_MODE_OUTPUT);
-    gpio_set_level(DS18B20_PIN, 0);
-    ets_delay_us(480);
-    gpio_set_direction(DS18B20_PIN, GPIO_MODE_INPUT);
-    ets_delay_us(70);
-    bool present = !gpio_get_level(DS18B20_PIN);
-    ets_delay_us(410);
-    return present;
-}
-
-static void onewire_write_bit(int bit) {
-    gpio_set_direction(DS18B20_PIN, GPIO_MODE_OUTPUT);
-    gpio_set_level(DS18B20_PIN, 0);
-    if (bit) {
-        ets_delay_us(6);
-        gpio_set_level(DS18B20_PIN, 1);
-        ets_delay_us(64);
-    } else {
-        ets_delay_us(60);
-        gpio_set_level(DS18B20_PIN, 1);
-        ets_delay_us(10);
+typedef enum {
+    DS18B20_STATE_IDLE,         // No conversion started
+    DS18B20_STATE_CONVERTING,   // Convert T issued, waiting for the timer
+    DS18B20_STATE_READY,        // Conversion done, scratchpad can be read
+} ds18b20_state_t;
+
+static volatile ds18b20_state_t s_state = DS18B20_STATE_IDLE;
+static esp_timer_handle_t s_conversion_timer;
+static uint32_t s_conversion_time_us = 750000; // Until the sensors' resolution is known
+static ds18b20_ready_cb_t s_ready_cb;
+static void *s_ready_cb_arg;
+
+// Devices found by the last Search ROM sweep
+static ds18b20_device_t s_devices[DS18B20_MAX_DEVICES];
+static size_t s_device_count;
+
+// 1-Wire transport: UART backend when available, bit-banged GPIO as fallback
+static onewire_uart_t s_uart_bus;
+static onewire_gpio_t s_gpio_bus;
+static onewire_bus_t *s_bus;
+
+// Read and decode the scratchpad of one device, retrying corrupted reads.
+// Configuration-only reads (config_only) accept the power-on scratchpad:
+// its configuration register is valid, just the temperature is not.
+static esp_err_t ds18b20_read_device(ds18b20_device_t *dev, uint8_t data[DS18B20_SCRATCHPAD_SIZE],
+                                     bool config_only) {
+    uint32_t backoff_ms = DS18B20_READ_BACKOFF_MS;
+    esp_err_t err = ESP_FAIL;
+
+    for (int attempt = 0; attempt < DS18B20_READ_ATTEMPTS; attempt++) {
+        if (attempt > 0) {
+            TickType_t ticks = pdMS_TO_TICKS(backoff_ms);
+            vTaskDelay(ticks > 0 ? ticks : 1);
+            backoff_ms *= 2;
+        }
+
+        onewire_status_t status = ds18b20_proto_read_scratchpad(s_bus, dev->rom, data);
+        if (status == ONEWIRE_ERR_DATA && config_only && ds18b20_proto_is_power_on(data)) {
+            dev->resolution = ds18b20_proto_resolution(data);
+            return ESP_OK;
+        }
+        if (status == ONEWIRE_OK) {
+            // Only a validated scratchpad ever updates the published value
+            dev->temperature = ds18b20_proto_temperature(data);
+            dev->resolution = ds18b20_proto_resolution(data);
+            ESP_LOGD(DS18B20_TAG, "Raw temperature data: 0x%02X%02X, Temperature: %.2f°C",
+                     data[1], data[0], dev->temperature);
+            return ESP_OK;
+        }
+
+        if (status == ONEWIRE_ERR_NO_PRESENCE) {
+            dev->bus_errors++;
+            err = ESP_ERR_NOT_FOUND;
+        } else {
+            dev->crc_errors++;
+            err = ESP_ERR_INVALID_CRC;
+        }
+        ESP_LOGD(DS18B20_TAG, "Sensor %s read attempt %d failed (%d)", dev->name, attempt + 1, status);
     }
-}
 
-static int onewire_read_bit(void) {
-    gpio_set_direction(DS18B20_PIN, GPIO_MODE_OUTPUT);
-    gpio_set_level(DS18B20_PIN, 0);
-    ets_delay_us(6);
-    gpio_set_level(DS18B20_PIN, 1);
-    ets_delay_us(9);
-    gpio_set_direction(DS18B20_PIN, GPIO_MODE_INPUT);
-    int bit = gpio_get_level(DS18B20_PIN);
-    ets_delay_us(55);
-    return bit;
+    dev->failed_reads++;
+    return err;
 }
 
-static void onewire_write_byte(uint8_t byte) {
-    for (int i = 0; i < 8; i++) {
-        onewire_write_bit(byte & 0x01);
-        byte >>= 1;
+// The shared Convert T must wait for the slowest sensor
+static void ds18b20_update_conversion_time(void) {
+    uint8_t max_bits = DS18B20_RESOLUTION_MIN;
+    for (size_t i = 0; i < s_device_count; i++) {
+        if (s_devices[i].resolution > max_bits) {
+            max_bits = s_devices[i].resolution;
+        }
     }
+    s_conversion_time_us = ds18b20_proto_conversion_time_us(s_device_count > 0 ? max_bits : DS18B20_RESOLUTION_MAX);
 }
 
-static uint8_t onewire_read_byte(void) {
-    uint8_t byte = 0;
-    for (int i = 0; i < 8; i++) {
-        byte >>= 1;
-        if (onewire_read_bit()) {
-            byte |= 0x80;
-        }
+// esp_timer callback - conversion time elapsed
+static void ds18b20_conversion_done(void *arg) {
+    s_state = DS18B20_STATE_READY;
+    if (s_ready_cb) {
+        s_ready_cb(s_ready_cb_arg);
     }
-    return byte;
 }
 
 // Public functions
 void ds18b20_init(void) {
-    gpio_reset_pin(DS18B20_PIN);
-    gpio_set_direction(DS18B20_PIN, GPIO_MODE_OUTPUT);
-    gpio_set_level(DS18B20_PIN, 1);
+    if (s_bus == NULL) {
+#if DS18B20_USE_UART_BUS
+        if (onewire_uart_init(&s_uart_bus, DS18B20_UART_PORT, DS18B20_PIN) == ESP_OK) {
+            s_bus = &s_uart_bus.bus;
+        } else {
+            ESP_LOGW(DS18B20_TAG, "UART 1-Wire unavailable, falling back to GPIO bit-bang");
+        }
+#endif
+        if (s_bus == NULL) {
+            onewire_gpio_init(&s_gpio_bus, DS18B20_PIN);
+            s_bus = &s_gpio_bus.bus;
+        }
+    }
+
+    if (s_conversion_timer == NULL) {
+        const esp_timer_create_args_t timer_args = {
+            .callback = ds18b20_conversion_done,
+            .name = "ds18b20_conv",
+        };
+        ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_conversion_timer));
+    }
     
     ESP_LOGI(DS18B20_TAG, "DS18B20 sensor initialized on GPIO %d", DS18B20_PIN);
     
-    // Check if sensor is present
-    if (ds18b20_is_present()) {
-        ESP_LOGI(DS18B20_TAG, "DS18B20 sensor detected successfully");
+    // Enumerate all sensors on the bus
+    if (ds18b20_scan_bus() > 0) {
+        ESP_LOGI(DS18B20_TAG, "%u DS18B20 sensor(s) detected", (unsigned)s_device_count);
+        if (ds18b20_set_resolution(DS18B20_RESOLUTION, false) != ESP_OK) {
+            ESP_LOGW(DS18B20_TAG, "Could not set %d-bit resolution on every sensor", DS18B20_RESOLUTION);
+        }
     } else {
         ESP_LOGW(DS18B20_TAG, "No DS18B20 sensor detected - check wiring");
     }
 }
 
+// Previous table entry for a ROM code, NULL for a new sensor
+static const ds18b20_device_t *ds18b20_find_device(const ds18b20_device_t *table, size_t count, const uint8_t rom[8]) {
+    for (size_t i = 0; i < count; i++) {
+        if (memcmp(table[i].rom, rom, sizeof(table[i].rom)) == 0) {
+            return &table[i];
+        }
+    }
+    return NULL;
+}
+
+size_t ds18b20_scan_bus(void) {
+    static ds18b20_device_t previous[DS18B20_MAX_DEVICES];
+    uint8_t roms[DS18B20_MAX_DEVICES][8];
+    size_t previous_count = s_device_count;
+    memcpy(previous, s_devices, sizeof(previous));
+    s_device_count = ds18b20_proto_search(s_bus, roms, DS18B20_MAX_DEVICES);
+
+    for (size_t i = 0; i < s_device_count; i++) {
+        ds18b20_device_t *dev = &s_devices[i];
+        const ds18b20_device_t *known = ds18b20_find_device(previous, previous_count, roms[i]);
+        if (known) {
+            // Same sensor: keep its counters and last reading
+            *dev = *known;
+            dev->consecutive_failures = 0;
+            continue;
+        }
+
+        memset(dev, 0, sizeof(*dev));
+        memcpy(dev->rom, roms[i], sizeof(dev->rom));
+        // Channel name from the 48-bit serial number (ROM bytes 6..1)
+        snprintf(dev->name, sizeof(dev->name), "ds18b20_%02x%02x%02x%02x%02x%02x",
+                 dev->rom[6], dev->rom[5], dev->rom[4], dev->rom[3], dev->rom[2], dev->rom[1]);
+        dev->resolution = DS18B20_RESOLUTION_MAX;
+
+        // Resolution may have been persisted to EEPROM by an earlier run
+        uint8_t data[DS18B20_SCRATCHPAD_SIZE];
+        ds18b20_read_device(dev, data, true);
+        ESP_LOGI(DS18B20_TAG, "Found sensor %s (%d-bit)", dev->name, dev->resolution);
+    }
+    for (size_t i = 0; i < previous_count; i++) {
+        if (!ds18b20_find_device(s_devices, s_device_count, previous[i].rom)) {
+            ESP_LOGW(DS18B20_TAG, "Sensor %s is gone", previous[i].name);
+        }
+    }
+    ds18b20_update_conversion_time();
+    return s_device_count;
+}
+
+size_t ds18b20_get_device_count(void) {
+    return s_device_count;
+}
+
+const ds18b20_device_t *ds18b20_get_device(size_t index) {
+    return index < s_device_count ? &s_devices[index] : NULL;
+}
+
 bool ds18b20_is_present(void) {
-    return onewire_presence_pulse();
+    return s_bus->reset(s_bus);
+}
+
+esp_err_t ds18b20_set_resolution(uint8_t bits, bool persist) {
+    if (bits < DS18B20_RESOLUTION_MIN || bits > DS18B20_RESOLUTION_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_state == DS18B20_STATE_CONVERTING) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const uint8_t config = DS18B20_CONFIG_FOR_RESOLUTION(bits);
+    esp_err_t result = ESP_OK;
+    for (size_t i = 0; i < s_device_count; i++) {
+        ds18b20_device_t *dev = &s_devices[i];
+        uint8_t data[DS18B20_SCRATCHPAD_SIZE];
+
+        // Write Scratchpad always sets TH and TL too: keep the current alarm thresholds
+        esp_err_t err = ds18b20_read_device(dev, data, true);
+        if (err == ESP_OK && data[4] != config) {
+            if (ds18b20_proto_write_scratchpad(s_bus, dev->rom, data[2], data[3], config) != ONEWIRE_OK) {
+                err = ESP_ERR_NOT_FOUND;
+            } else if ((err = ds18b20_read_device(dev, data, true)) == ESP_OK && data[4] != config) {
+                err = ESP_ERR_INVALID_RESPONSE;
+            }
+        }
+        if (err == ESP_OK && persist) {
+            if (ds18b20_proto_copy_scratchpad(s_bus, dev->rom) != ONEWIRE_OK) {
+                err = ESP_ERR_NOT_FOUND;
+            } else {
+                vTaskDelay(pdMS_TO_TICKS(DS18B20_EEPROM_WRITE_TIME_MS) + 1);
+            }
+        }
+
+        if (err != ESP_OK) {
+            ESP_LOGW(DS18B20_TAG, "Sensor %s: setting %d-bit resolution failed", dev->name, bits);
+            if (result == ESP_OK) {
+                result = err;
+            }
+        }
+    }
+
+    ds18b20_update_conversion_time();
+    ESP_LOGI(DS18B20_TAG, "Conversion time %u us", (unsigned)s_conversion_time_us);
+    return result;
 }
 
-float ds18b20_read_temperature(void) {
-    if (!onewire_presence_pulse()) {
+uint32_t ds18b20_get_conversion_time_us(void) {
+    return s_conversion_time_us;
+}
+
+void ds18b20_set_ready_callback(ds18b20_ready_cb_t cb, void *arg) {
+    s_ready_cb = cb;
+    s_ready_cb_arg = arg;
+}
+
+esp_err_t ds18b20_start_conversion(void) {
+    if (s_state == DS18B20_STATE_CONVERTING) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Broadcast: every sensor on the bus converts in parallel.
+    // The reset pulse doubles as the presence check.
+    if (ds18b20_proto_convert_all(s_bus) != ONEWIRE_OK) {
         ESP_LOGE(DS18B20_TAG, "No DS18B20 sensor present");
-        return -999.0; // Error value
+        return ESP_ERR_NOT_FOUND;
     }
-    
-    onewire_reset();
-    onewire_write_byte(0xCC); // Skip ROM command
-    onewire_write_byte(0x44); // Convert temperature command
-    
-    // Wait for conversion (max 750ms for 12-bit resolution)
-    vTaskDelay(750 / portTICK_PERIOD_MS);
-    
-    onewire_reset();
-    onewire_write_byte(0xCC); // Skip ROM command
-    onewire_write_byte(0xBE); // Read Scratchpad command
-    
-    // Read 9 bytes from scratchpad
-    uint8_t data[9];
-    for (int i = 0; i < 9; i++) {
-        data[i] = onewire_read_byte();
+
+    s_state = DS18B20_STATE_CONVERTING;
+    esp_timer_start_once(s_conversion_timer, s_conversion_time_us);
+    return ESP_OK;
+}
+
+esp_err_t ds18b20_poll(void) {
+    if (s_state == DS18B20_STATE_CONVERTING) {
+        return ESP_ERR_NOT_FINISHED;
     }
-    
-    // Calculate CRC8 checksum
-    uint8_t crc = 0;
-    for (int i = 0; i < 8; i++) {
-        uint8_t inbyte = data[i];
-        for (int j = 0; j < 8; j++) {
-            uint8_t mix = (crc ^ inbyte) & 0x01;
-            crc >>= 1;
-            if (mix) crc ^= 0x8C;
-            inbyte >>= 1;
+    if (s_state != DS18B20_STATE_READY) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_state = DS18B20_STATE_IDLE;
+
+    // Collect every sensor's result with Match ROM reads
+    esp_err_t result = ESP_ERR_NOT_FOUND;
+    for (size_t i = 0; i < s_device_count; i++) {
+        ds18b20_device_t *dev = &s_devices[i];
+        uint8_t data[DS18B20_SCRATCHPAD_SIZE];
+        esp_err_t err = ds18b20_read_device(dev, data, false);
+        dev->valid = err == ESP_OK;
+        dev->consecutive_failures = dev->valid ? 0 : dev->consecutive_failures + 1;
+        if (dev->valid) {
+            result = ESP_OK;
+        } else if (err == ESP_ERR_INVALID_CRC) {
+            ESP_LOGW(DS18B20_TAG, "Sensor %s: CRC error, reading dropped (%u CRC errors so far)",
+                     dev->name, (unsigned)dev->crc_errors);
+            if (result != ESP_OK) {
+                result = ESP_ERR_INVALID_CRC;
+            }
+        } else {
+            ESP_LOGW(DS18B20_TAG, "Sensor %s did not respond", dev->name);
         }
     }
-    
-    if (crc != data[8]) {
-        ESP_LOGW(DS18B20_TAG, "CRC mismatch - temperature reading may be invalid");
+    return result;
+}
+
+esp_err_t ds18b20_read_temperature(float *temperature) {
+    esp_err_t err = ds18b20_start_conversion();
+    if (err != ESP_OK) {
+        return err;
     }
-    
-    // Calculate temperature from raw data
-    int16_t temp_raw = (data[1] << 8) | data[0];
-    float temperature = temp_raw / 16.0;
-    
-    ESP_LOGD(DS18B20_TAG, "Raw temperature data: 0x%04X, Temperature: %.2f°C", temp_raw, temperature);
-    
-    return temperature;
-}
\ No newline at end of file
+
+    // Blocking wrapper: sleep in short steps until the conversion timer fires
+    while ((err = ds18b20_poll()) == ESP_ERR_NOT_FINISHED) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (!s_devices[0].valid) {
+        return ESP_ERR_INVALID_RESPONSE; // Another sensor answered, the first one did not
+    }
+    *temperature = s_devices[0].temperature;
+    return ESP_OK;
+}
+
+// esp_timer callback adapter - wakes the sensor task
+static void ds18b20_notify_task(void *arg) {
+    xTaskNotifyGive((TaskHandle_t)arg);
+}
+
+// A sensor keeps failing (unplugged or replaced) or the periodic rescan is due
+static bool ds18b20_rescan_needed(int64_t last_scan_us) {
+    if (s_device_count == 0 ||
+        esp_timer_get_time() - last_scan_us >= (int64_t)DS18B20_RESCAN_PERIOD_MS * 1000) {
+        return true;
+    }
+    for (size_t i = 0; i < s_device_count; i++) {
+        if (s_devices[i].consecutive_failures >= DS18B20_RESCAN_FAILURES) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sensor task - converts all sensors at once, sleeps until ready and publishes each one
+static void ds18b20_task(void *parameter) {
+    ds18b20_init();
+    ds18b20_set_ready_callback(ds18b20_notify_task, xTaskGetCurrentTaskHandle());
+    int64_t last_scan_us = esp_timer_get_time();
+
+    while (1) {
+        // Rebuild the device table: sensors added, removed or replaced after boot
+        if (ds18b20_rescan_needed(last_scan_us)) {
+            size_t previous_count = s_device_count;
+            last_scan_us = esp_timer_get_time();
+            if (ds18b20_scan_bus() == 0) {
+                vTaskDelay(pdMS_TO_TICKS(DS18B20_RETRY_DELAY_MS));
+                continue;
+            }
+            if (s_device_count != previous_count) {
+                ESP_LOGI(DS18B20_TAG, "%u DS18B20 sensor(s) on the bus", (unsigned)s_device_count);
+            }
+            // New sensors start at their power-up resolution
+            for (size_t i = 0; i < s_device_count; i++) {
+                if (s_devices[i].resolution != DS18B20_RESOLUTION) {
+                    ds18b20_set_resolution(DS18B20_RESOLUTION, false);
+                    break;
+                }
+            }
+        }
+
+        int64_t started_us = esp_timer_get_time();
+        if (ds18b20_start_conversion() != ESP_OK) {
+            vTaskDelay(pdMS_TO_TICKS(DS18B20_RETRY_DELAY_MS));
+            continue;
+        }
+
+        // The task is blocked (not spinning) for the whole conversion
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        ds18b20_poll();
+        for (size_t i = 0; i < s_device_count; i++) {
+            if (s_devices[i].valid) {
+                teleplot_publish_at(s_devices[i].name, s_devices[i].temperature, started_us);
+            }
+        }
+
+        // The LCD shows the first sensor; it only wakes if the value changed
+        ssd1306_publish(DISPLAY_SOURCE_TEMPERATURE, s_devices[0].valid ?
+                        display_value_number(s_devices[0].temperature) : display_value_none());
+    }
+}
+
+void start_ds18b20_task(void) {
+    BaseType_t result = xTaskCreate(
+        ds18b20_task,           // Function that implements the task
+        "DS18B20_Task",         // Text name for the task
+        3072,                   // Stack size in bytes
+        NULL,                   // Parameter passed to the task
+        5,                      // Priority (0-25, higher = more important)
+        NULL                    // Task handle
+    );
+
+    if (result != pdPASS) {
+        ESP_LOGE(DS18B20_TAG, "Failed to create DS18B20 task");
+    }
+}
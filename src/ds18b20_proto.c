@@ -0,0 +1,105 @@
+#include "ds18b20_proto.h"
+#include <string.h>
+
+size_t ds18b20_proto_search(onewire_bus_t *bus, uint8_t roms[][8], size_t max_devices) {
+    onewire_search_t search = { 0 };
+    size_t count = 0;
+
+    while (count < max_devices && onewire_search_next(bus, &search)) {
+        if (!onewire_rom_valid(search.rom)) {
+            continue; // Corrupted ROM code
+        }
+        if (search.rom[0] != DS18B20_FAMILY_CODE) {
+            continue; // Other 1-Wire device types may share the bus
+        }
+        memcpy(roms[count++], search.rom, 8);
+    }
+    return count;
+}
+
+onewire_status_t ds18b20_proto_convert_all(onewire_bus_t *bus) {
+    onewire_status_t status = onewire_skip_rom(bus);
+    if (status != ONEWIRE_OK) {
+        return status;
+    }
+    const uint8_t cmd = DS18B20_CMD_CONVERT_T;
+    bus->write_bytes(bus, &cmd, 1);
+    return ONEWIRE_OK;
+}
+
+onewire_status_t ds18b20_proto_read_scratchpad(onewire_bus_t *bus, const uint8_t rom[8],
+                                               uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE]) {
+    onewire_status_t status = onewire_match_rom(bus, rom);
+    if (status != ONEWIRE_OK) {
+        return status;
+    }
+    const uint8_t cmd = DS18B20_CMD_READ_SCRATCHPAD;
+    bus->write_bytes(bus, &cmd, 1);
+    bus->read_bytes(bus, scratchpad, DS18B20_SCRATCHPAD_SIZE);
+
+    if (onewire_crc8(scratchpad, DS18B20_SCRATCHPAD_SIZE - 1) != scratchpad[DS18B20_SCRATCHPAD_SIZE - 1]) {
+        return ONEWIRE_ERR_CRC;
+    }
+    // An all-zero scratchpad (bus held low) has a valid CRC; the configuration
+    // register's fixed bits catch it
+    if ((scratchpad[4] & DS18B20_CONFIG_FIXED_MASK) != DS18B20_CONFIG_FIXED_BITS) {
+        return ONEWIRE_ERR_DATA;
+    }
+    // 85.0 C straight after power-up: no conversion has run since the sensor reset
+    if (ds18b20_proto_is_power_on(scratchpad)) {
+        return ONEWIRE_ERR_DATA;
+    }
+    return ONEWIRE_OK;
+}
+
+// Address one device, or all of them when rom is NULL
+static onewire_status_t ds18b20_proto_select(onewire_bus_t *bus, const uint8_t rom[8]) {
+    return rom ? onewire_match_rom(bus, rom) : onewire_skip_rom(bus);
+}
+
+onewire_status_t ds18b20_proto_write_scratchpad(onewire_bus_t *bus, const uint8_t rom[8],
+                                                uint8_t th, uint8_t tl, uint8_t config) {
+    onewire_status_t status = ds18b20_proto_select(bus, rom);
+    if (status != ONEWIRE_OK) {
+        return status;
+    }
+    const uint8_t frame[4] = { DS18B20_CMD_WRITE_SCRATCHPAD, th, tl, config };
+    bus->write_bytes(bus, frame, sizeof(frame));
+    return ONEWIRE_OK;
+}
+
+onewire_status_t ds18b20_proto_copy_scratchpad(onewire_bus_t *bus, const uint8_t rom[8]) {
+    onewire_status_t status = ds18b20_proto_select(bus, rom);
+    if (status != ONEWIRE_OK) {
+        return status;
+    }
+    const uint8_t cmd = DS18B20_CMD_COPY_SCRATCHPAD;
+    bus->write_bytes(bus, &cmd, 1);
+    return ONEWIRE_OK;
+}
+
+bool ds18b20_proto_is_power_on(const uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE]) {
+    uint16_t raw = (uint16_t)(scratchpad[0] | (scratchpad[1] << 8));
+    return raw == DS18B20_POWER_ON_RAW && scratchpad[5] == DS18B20_RESERVED_5_RESET &&
+           scratchpad[7] == DS18B20_RESERVED_7_RESET;
+}
+
+uint8_t ds18b20_proto_resolution(const uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE]) {
+    return DS18B20_RESOLUTION_MIN + ((scratchpad[4] >> 5) & 0x03);
+}
+
+uint32_t ds18b20_proto_conversion_time_us(uint8_t resolution) {
+    if (resolution < DS18B20_RESOLUTION_MIN || resolution > DS18B20_RESOLUTION_MAX) {
+        resolution = DS18B20_RESOLUTION_MAX;
+    }
+    // 750 ms at 12 bits, halved for every bit less
+    return 750000u >> (DS18B20_RESOLUTION_MAX - resolution);
+}
+
+float ds18b20_proto_temperature(const uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE]) {
+    int16_t temp_raw = (scratchpad[1] << 8) | scratchpad[0];
+    // 11 bits leave bit 0 undefined, 10 bits bits 1-0, 9 bits bits 2-0
+    int undefined_bits = DS18B20_RESOLUTION_MAX - ds18b20_proto_resolution(scratchpad);
+    temp_raw &= ~((1 << undefined_bits) - 1);
+    return temp_raw / 16.0f;
+}
@@ -9,118 +9,47 @@
 #include "sdkconfig.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "freertos/event_groups.h"
 #include "esp_chip_info.h"
 #include "esp_flash.h"
-#include "esp_wifi.h"
-#include "esp_event.h"
+#include "esp_system.h"
 #include "esp_log.h"
 #include "nvs_flash.h"
 #include "driver/gpio.h"
 #include "teleplot_udp.h"
 #include "ssd1306_display.h"
-#include "host_ip.h"
+#include "ds18b20.h"
+#include "wifi_sta.h"
+#include "sched_task.h"
+#include "power_mode.h"
+#include "sys_profiler.h"
 
-#define WIFI_MAXIMUM_RETRY  5
 // gpio15 led on xiao board
 #define LED_PIN            15
 
-#define WIFI_CONNECTED_BIT BIT0
-#define WIFI_FAIL_BIT      BIT1
+// Odświeżanie siły sygnału na wyświetlaczu
+#define WIFI_RSSI_PERIOD_MS 5000
 
-static EventGroupHandle_t s_wifi_event_group;
 static const char *TAG = "wifi station";
-static int s_retry_num = 0;
 
-// Event handler dla WiFi
-static void event_handler(void* arg, esp_event_base_t event_base,
-                                int32_t event_id, void* event_data)
+// Stan WiFi na wyświetlaczu: siła sygnału albo brak połączenia
+static void wifi_state_to_display(bool connected, int rssi, void *arg)
 {
-    if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
-        esp_wifi_connect();
-    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
-        if (s_retry_num < WIFI_MAXIMUM_RETRY) {
-            esp_wifi_connect();
-            s_retry_num++;
-            ESP_LOGI(TAG, "retry to connect to the AP");
-        } else {
-            xEventGroupSetBits(s_wifi_event_group, WIFI_FAIL_BIT);
-        }
-        ESP_LOGI(TAG,"connect to the AP fail");
-    } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
-        ip_event_got_ip_t* event = (ip_event_got_ip_t*) event_data;
-        ESP_LOGI(TAG, "got ip:" IPSTR, IP2STR(&event->ip_info.ip));
-        s_retry_num = 0;
-        xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
-    }
+    ssd1306_publish(DISPLAY_SOURCE_WIFI, connected ? display_value_integer(rssi) : display_value_none());
 }
 
-// Funkcja inicjalizująca WiFi
-void wifi_init_sta(void)
-{
-    s_wifi_event_group = xEventGroupCreate();
-
-    ESP_ERROR_CHECK(esp_netif_init());
-    ESP_ERROR_CHECK(esp_event_loop_create_default());
-    esp_netif_create_default_wifi_sta();
-
-    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
-    ESP_ERROR_CHECK(esp_wifi_init(&cfg));
-
-    esp_event_handler_instance_t instance_any_id;
-    esp_event_handler_instance_t instance_got_ip;
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT,
-                                                        ESP_EVENT_ANY_ID,
-                                                        &event_handler,
-                                                        NULL,
-                                                        &instance_any_id));
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT,
-                                                        IP_EVENT_STA_GOT_IP,
-                                                        &event_handler,
-                                                        NULL,
-                                                        &instance_got_ip));
-
-    wifi_config_t wifi_config = {
-        .sta = {
-            .ssid = WIFI_SSID,
-            .password = WIFI_PASS,
-            .threshold.authmode = WIFI_AUTH_WPA2_PSK,
-        },
-    };
-    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA) );
-    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config) );
-    ESP_ERROR_CHECK(esp_wifi_start() );
-
-    ESP_LOGI(TAG, "wifi_init_sta finished.");
-
-    /* Waiting until either the connection is established (WIFI_CONNECTED_BIT) or connection failed for the maximum
-     * number of re-tries (WIFI_FAIL_BIT). The bits are set by event_handler() (see above) */
-    EventBits_t bits = xEventGroupWaitBits(s_wifi_event_group,
-            WIFI_CONNECTED_BIT | WIFI_FAIL_BIT,
-            pdFALSE,
-            pdFALSE,
-            portMAX_DELAY);
-
-    /* xEventGroupWaitBits() returns the bits before the call returned, hence we can test which event actually
-     * happened. */
-    if (bits & WIFI_CONNECTED_BIT) {
-        ESP_LOGI(TAG, "connected to ap SSID:%s password:%s",
-                 WIFI_SSID, WIFI_PASS);
-    } else if (bits & WIFI_FAIL_BIT) {
-        ESP_LOGI(TAG, "Failed to connect to SSID:%s, password:%s",
-                 WIFI_SSID, WIFI_PASS);
-    } else {
-        ESP_LOGE(TAG, "UNEXPECTED EVENT");
+// Siła sygnału zmienia się w trakcie połączenia - obserwator widzi ją tylko przy
+// zmianie stanu, więc w czasie połączenia odczytujemy ją okresowo
+static void wifi_rssi_job(void *arg) {
+    int rssi;
+    if (wifi_sta_get_rssi(&rssi)) {
+        ssd1306_publish(DISPLAY_SOURCE_WIFI, display_value_integer(rssi));
     }
 }
-// Funkcja dla dodatkowego wątku
-void additional_task(void *parameter) {
-    int counter = 0;
-    
-    while(1) {
-        printf("[Dodatkowy wątek] Licznik: %d\n", counter++);
-        vTaskDelay(2000 / portTICK_PERIOD_MS); // Opóźnienie 2 sekundy
-    }
+
+// Zadanie licznika (dawniej osobny wątek) - co 2 s w planiście
+static void counter_job(void *parameter) {
+    static int counter = 0;
+    printf("[Dodatkowy wątek] Licznik: %d\n", counter++);
 }
 
 // Funkcja konfiguracji LED
@@ -135,28 +64,14 @@ void configure_led(void) {
     gpio_config(&io_conf);
 }
 
-// Task migającej LED
-void led_blink_task(void *parameter) {
+// Zadanie migającej LED - co 1 s zmienia stan
+static void led_blink_job(void *parameter) {
     static const char *LED_TAG = "LED_BLINK";
-    configure_led();
-    
-    ESP_LOGI(LED_TAG, "LED blink task started on GPIO %d", LED_PIN);
-    
-    while(1) {
-        // Włącz LED
-        gpio_set_level(LED_PIN, 1);
-        ESP_LOGI(LED_TAG, "LED ON");
-        
-        // Poczekaj 1000ms
-        vTaskDelay(1000 / portTICK_PERIOD_MS);
-        
-        // Wyłącz LED
-        gpio_set_level(LED_PIN, 0);
-        ESP_LOGI(LED_TAG, "LED OFF");
-        
-        // Poczekaj 1000ms
-        vTaskDelay(1000 / portTICK_PERIOD_MS);
-    }
+    static int level = 0;
+
+    level = !level;
+    gpio_set_level(LED_PIN, level);
+    ESP_LOGI(LED_TAG, "LED %s", level ? "ON" : "OFF");
 }
 
 void app_main(void)
@@ -171,15 +86,21 @@ void app_main(void)
     }
     ESP_ERROR_CHECK(ret);
 
+    // Zarządzanie energią przed WiFi (modem sleep) i planistą (okna wybudzeń)
+    power_mode_init();
+
+    // Pomiary i wyświetlacz ruszają od razu, bez czekania na sieć
+    start_lcd_display_task();
+    start_ds18b20_task();
+
+    // WiFi łączy się w tle; stan trafia do obserwatorów i grupy zdarzeń
     ESP_LOGI(TAG, "ESP_WIFI_MODE_STA");
-    wifi_init_sta();
+    wifi_sta_subscribe(wifi_state_to_display, NULL);
+    wifi_sta_start();
 
-    // Uruchom wątek Teleplot UDP po połączeniu WiFi
+    // Teleplot buforuje próbki offline i zaczyna wysyłać po IP_EVENT_STA_GOT_IP
     start_teleplot_udp_task();
-    
-    // Start LCD display task
-    start_lcd_display_task();
-    
+
     // Start TCP client task
     //start_tcp_client_task();
     
@@ -189,28 +110,20 @@ void app_main(void)
     uint32_t flash_size;
     esp_chip_info(&chip_info);
 
-    // Tworzenie dodatkowego wątku
-    xTaskCreate(
-        additional_task,        // Funkcja wątku
-        "AdditionalTask",       // Nazwa wątku
-        2048,                   // Rozmiar stosu w słowach
-        NULL,                   // Parametr przekazywany do wątku
-        5,                      // Priorytet (0-25, wyższe = ważniejsze)
-        NULL                    // Handle do wątku (opcjonalne)
-    );
-
-    // Tworzenie wątku migającej LED
-    xTaskCreate(
-        led_blink_task,         // Funkcja wątku
-        "LED_Blink_Task",       // Nazwa wątku
-        2048,                   // Rozmiar stosu w słowach
-        NULL,                   // Parametr przekazywany do wątku
-        5,                      // Priorytet (0-25, wyższe = ważniejsze)
-        NULL                    // Handle do wątku (opcjonalne)
-    );
-
-    printf("Dodatkowy wątek został utworzony!\n");
-    printf("LED blink task został utworzony!\n");
+    // Zadania okresowe dzielą jeden wątek i jeden stos; zapas pozwala
+    // LED i licznikowi budzić się razem
+    configure_led();
+    sched_add("led", 1000, 50, led_blink_job, NULL);
+    sched_add("counter", 2000, 100, counter_job, NULL);
+    sched_add("wifi_rssi", WIFI_RSSI_PERIOD_MS, WIFI_RSSI_PERIOD_MS / 10, wifi_rssi_job, NULL);
+#if POWER_LOW_POWER_MODE
+    // Log co sekundę trzymałby CPU w UART; LED miga dalej bez logów
+    esp_log_level_set("LED_BLINK", ESP_LOG_WARN);
+#endif
+    sys_profiler_start();
+    sched_start();
+
+    printf("Zadania LED i licznika dodane do planisty!\n");
 
     printf("This is %s chip with %d CPU core(s), WiFi%s%s, ",
            CONFIG_IDF_TARGET,
@@ -231,6 +144,7 @@ void app_main(void)
 
     printf("Minimum free heap size: %d bytes\n", esp_get_minimum_free_heap_size());
 
+#if !POWER_LOW_POWER_MODE
     for (int i = 50; i >= 0; i--) {
         printf("Restarting in %d seconds...\n", i);
         vTaskDelay(1000 / portTICK_PERIOD_MS);
@@ -238,4 +152,5 @@ void app_main(void)
     printf("Restarting now.\n");
     fflush(stdout);
     esp_restart();
+#endif
 }
@@ -0,0 +1,98 @@
+#include "job_sched.h"
+
+#include <stddef.h>
+
+int job_sched_add(job_sched_t *sched, const char *name, uint32_t period_ms, uint32_t slack_ms,
+                  job_fn_t fn, void *arg) {
+    int id = atomic_load_explicit(&sched->count, memory_order_relaxed);
+    if (id >= JOB_SCHED_MAX_JOBS || period_ms == 0 || fn == NULL) {
+        return -1;
+    }
+
+    job_t *job = &sched->jobs[id];
+    job->name = name;
+    job->fn = fn;
+    job->arg = arg;
+    job->period_us = (int64_t)period_ms * 1000;
+    // Zapas nie większy niż pół okresu, inaczej zadanie wyprzedzałoby samo siebie
+    job->slack_us = (int64_t)(slack_ms < period_ms / 2 ? slack_ms : period_ms / 2) * 1000;
+    job->active = false;
+    job->stats = (job_stats_t){ 0 };
+    atomic_store_explicit(&job->enabled, true, memory_order_relaxed);
+
+    // Planista widzi zadanie dopiero po pełnym wypełnieniu slotu
+    atomic_store_explicit(&sched->count, id + 1, memory_order_release);
+    return id;
+}
+
+void job_sched_set_enabled(job_sched_t *sched, int id, bool enabled) {
+    if (id >= 0 && id < job_sched_count(sched)) {
+        atomic_store_explicit(&sched->jobs[id].enabled, enabled, memory_order_relaxed);
+    }
+}
+
+void job_sched_set_window(job_sched_t *sched, uint32_t window_ms) {
+    sched->window_us = (int64_t)window_ms * 1000;
+}
+
+static void job_run(job_t *job, job_clock_t clock) {
+    int64_t start = clock();
+    job->fn(job->arg);
+    int64_t end = clock();
+
+    int64_t jitter = start > job->next_us ? start - job->next_us : job->next_us - start;
+    uint32_t run = (uint32_t)(end - start);
+    job_stats_t *stats = &job->stats;
+    stats->runs++;
+    stats->run_total_us += run;
+    stats->jitter_total_us += (uint64_t)jitter;
+    if (run > stats->run_max_us) {
+        stats->run_max_us = run;
+    }
+    if (jitter > stats->jitter_max_us) {
+        stats->jitter_max_us = (uint32_t)jitter;
+    }
+
+    // Terminy pozostają na siatce okresu; zaległych wywołań nie nadrabiamy
+    job->next_us += job->period_us;
+    if (job->next_us <= end) {
+        int64_t missed = (end - job->next_us) / job->period_us + 1;
+        job->next_us += missed * job->period_us;
+        stats->skipped += (uint32_t)missed;
+    }
+}
+
+int64_t job_sched_run_due(job_sched_t *sched, job_clock_t clock) {
+    int count = job_sched_count(sched);
+    int64_t now = clock();
+    sched->wakeups++;
+
+    for (int i = 0; i < count; i++) {
+        job_t *job = &sched->jobs[i];
+        bool enabled = atomic_load_explicit(&job->enabled, memory_order_relaxed);
+        if (enabled && !job->active) {
+            job->next_us = now;
+        }
+        job->active = enabled;
+    }
+
+    // Wszystko, co i tak wypadłoby w granicach zapasu, idzie w tym samym wybudzeniu
+    for (int i = 0; i < count; i++) {
+        job_t *job = &sched->jobs[i];
+        if (job->active && job->next_us - job->slack_us <= now) {
+            job_run(job, clock);
+        }
+    }
+
+    int64_t next = INT64_MAX;
+    for (int i = 0; i < count; i++) {
+        const job_t *job = &sched->jobs[i];
+        if (job->active && job->next_us < next) {
+            next = job->next_us;
+        }
+    }
+    if (sched->window_us > 0 && next != INT64_MAX) {
+        next = (next + sched->window_us - 1) / sched->window_us * sched->window_us;
+    }
+    return next;
+}
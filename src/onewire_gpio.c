@@ -0,0 +1,92 @@
+#include "onewire_gpio.h"
+#include "rom/ets_sys.h"
+#include "freertos/FreeRTOS.h"
+
+// Bit slots must not be stretched by interrupts - the slave samples at fixed times
+static portMUX_TYPE s_onewire_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Reset pulse followed by presence detection; returns true if a device answered
+static bool onewire_gpio_reset(onewire_bus_t *bus) {
+    gpio_num_t pin = ((onewire_gpio_t *)bus)->pin;
+
+    gpio_set_direction(pin, GPIO_MODE_OUTPUT);
+    gpio_set_level(pin, 0);
+    ets_delay_us(480);
+    portENTER_CRITICAL(&s_onewire_mux);
+    gpio_set_direction(pin, GPIO_MODE_INPUT);
+    ets_delay_us(70);
+    bool present = !gpio_get_level(pin);
+    portEXIT_CRITICAL(&s_onewire_mux);
+    ets_delay_us(410);
+    return present;
+}
+
+static void onewire_gpio_write_bit(onewire_bus_t *bus, int bit) {
+    gpio_num_t pin = ((onewire_gpio_t *)bus)->pin;
+
+    portENTER_CRITICAL(&s_onewire_mux);
+    gpio_set_direction(pin, GPIO_MODE_OUTPUT);
+    gpio_set_level(pin, 0);
+    if (bit) {
+        ets_delay_us(6);
+        gpio_set_level(pin, 1);
+        ets_delay_us(64);
+    } else {
+        ets_delay_us(60);
+        gpio_set_level(pin, 1);
+        ets_delay_us(10);
+    }
+    portEXIT_CRITICAL(&s_onewire_mux);
+}
+
+static int onewire_gpio_read_bit(onewire_bus_t *bus) {
+    gpio_num_t pin = ((onewire_gpio_t *)bus)->pin;
+
+    portENTER_CRITICAL(&s_onewire_mux);
+    gpio_set_direction(pin, GPIO_MODE_OUTPUT);
+    gpio_set_level(pin, 0);
+    ets_delay_us(6);
+    gpio_set_level(pin, 1);
+    ets_delay_us(9);
+    gpio_set_direction(pin, GPIO_MODE_INPUT);
+    int bit = gpio_get_level(pin);
+    portEXIT_CRITICAL(&s_onewire_mux);
+    ets_delay_us(55);
+    return bit;
+}
+
+static void onewire_gpio_write_bytes(onewire_bus_t *bus, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        uint8_t byte = data[i];
+        for (int b = 0; b < 8; b++) {
+            onewire_gpio_write_bit(bus, byte & 0x01);
+            byte >>= 1;
+        }
+    }
+}
+
+static void onewire_gpio_read_bytes(onewire_bus_t *bus, uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        uint8_t byte = 0;
+        for (int b = 0; b < 8; b++) {
+            byte >>= 1;
+            if (onewire_gpio_read_bit(bus)) {
+                byte |= 0x80;
+            }
+        }
+        data[i] = byte;
+    }
+}
+
+void onewire_gpio_init(onewire_gpio_t *gpio, gpio_num_t pin) {
+    gpio->pin = pin;
+    gpio->bus.reset = onewire_gpio_reset;
+    gpio->bus.write_bit = onewire_gpio_write_bit;
+    gpio->bus.read_bit = onewire_gpio_read_bit;
+    gpio->bus.write_bytes = onewire_gpio_write_bytes;
+    gpio->bus.read_bytes = onewire_gpio_read_bytes;
+
+    gpio_reset_pin(pin);
+    gpio_set_direction(pin, GPIO_MODE_OUTPUT);
+    gpio_set_level(pin, 1);
+}
@@ -0,0 +1,132 @@
+#include "onewire_uart.h"
+#include "esp_log.h"
+#include "esp_rom_gpio.h"
+#include "soc/uart_periph.h"
+#include "freertos/FreeRTOS.h"
+#include <string.h>
+
+#define ONEWIRE_UART_RESET_BAUD  9600
+#define ONEWIRE_UART_DATA_BAUD   115200
+#define ONEWIRE_UART_SLOT_ONE    0xFF    // Write 1 / read slot
+#define ONEWIRE_UART_SLOT_ZERO   0x00    // Write 0
+#define ONEWIRE_UART_RESET_SLOT  0xF0    // Reset pulse at 9600 baud
+#define ONEWIRE_UART_CHUNK_BYTES 8       // 1-Wire bytes per UART burst (64 slots)
+#define ONEWIRE_UART_RX_BUFFER   256     // Must exceed the hardware FIFO size
+#define ONEWIRE_UART_TIMEOUT_MS  20
+
+static const char *TAG = "onewire_uart";
+
+// Send slots and replace them with the echo read back from the bus
+static bool onewire_uart_exchange(onewire_uart_t *uart, uint8_t *slots, size_t len) {
+    uart_flush_input(uart->port);
+    uart_write_bytes(uart->port, slots, len);
+    int received = uart_read_bytes(uart->port, slots, len, pdMS_TO_TICKS(ONEWIRE_UART_TIMEOUT_MS));
+    if (received != (int)len) {
+        ESP_LOGW(TAG, "Echo timeout (%d/%u slots)", received, (unsigned)len);
+        return false;
+    }
+    return true;
+}
+
+static bool onewire_uart_reset(onewire_bus_t *bus) {
+    onewire_uart_t *uart = (onewire_uart_t *)bus;
+    uint8_t slot = ONEWIRE_UART_RESET_SLOT;
+
+    uart_set_baudrate(uart->port, ONEWIRE_UART_RESET_BAUD);
+    bool ok = onewire_uart_exchange(uart, &slot, 1);
+    uart_set_baudrate(uart->port, ONEWIRE_UART_DATA_BAUD);
+
+    // A presence pulse pulls some of the high data bits low
+    return ok && slot != ONEWIRE_UART_RESET_SLOT;
+}
+
+static void onewire_uart_write_bit(onewire_bus_t *bus, int bit) {
+    uint8_t slot = bit ? ONEWIRE_UART_SLOT_ONE : ONEWIRE_UART_SLOT_ZERO;
+    onewire_uart_exchange((onewire_uart_t *)bus, &slot, 1);
+}
+
+static int onewire_uart_read_bit(onewire_bus_t *bus) {
+    uint8_t slot = ONEWIRE_UART_SLOT_ONE;
+    if (!onewire_uart_exchange((onewire_uart_t *)bus, &slot, 1)) {
+        return 1; // Idle bus reads as 1
+    }
+    return slot == ONEWIRE_UART_SLOT_ONE;
+}
+
+static void onewire_uart_write_bytes(onewire_bus_t *bus, const uint8_t *data, size_t len) {
+    uint8_t slots[ONEWIRE_UART_CHUNK_BYTES * 8];
+
+    while (len > 0) {
+        size_t chunk = len < ONEWIRE_UART_CHUNK_BYTES ? len : ONEWIRE_UART_CHUNK_BYTES;
+        for (size_t i = 0; i < chunk; i++) {
+            for (int b = 0; b < 8; b++) {
+                slots[i * 8 + b] = (data[i] >> b) & 0x01 ? ONEWIRE_UART_SLOT_ONE : ONEWIRE_UART_SLOT_ZERO;
+            }
+        }
+        onewire_uart_exchange((onewire_uart_t *)bus, slots, chunk * 8);
+        data += chunk;
+        len -= chunk;
+    }
+}
+
+static void onewire_uart_read_bytes(onewire_bus_t *bus, uint8_t *data, size_t len) {
+    uint8_t slots[ONEWIRE_UART_CHUNK_BYTES * 8];
+
+    while (len > 0) {
+        size_t chunk = len < ONEWIRE_UART_CHUNK_BYTES ? len : ONEWIRE_UART_CHUNK_BYTES;
+        memset(slots, ONEWIRE_UART_SLOT_ONE, chunk * 8);
+        bool ok = onewire_uart_exchange((onewire_uart_t *)bus, slots, chunk * 8);
+        for (size_t i = 0; i < chunk; i++) {
+            uint8_t byte = 0;
+            for (int b = 0; b < 8; b++) {
+                if (!ok || slots[i * 8 + b] == ONEWIRE_UART_SLOT_ONE) {
+                    byte |= 1 << b;
+                }
+            }
+            data[i] = byte;
+        }
+        data += chunk;
+        len -= chunk;
+    }
+}
+
+esp_err_t onewire_uart_init(onewire_uart_t *uart, uart_port_t port, gpio_num_t pin) {
+    const uart_config_t config = {
+        .baud_rate = ONEWIRE_UART_DATA_BAUD,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+
+    esp_err_t err = uart_driver_install(port, ONEWIRE_UART_RX_BUFFER, 0, 0, NULL, 0);
+    if (err != ESP_OK) {
+        return err;
+    }
+    err = uart_param_config(port, &config);
+    if (err == ESP_OK) {
+        err = uart_set_pin(port, pin, pin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    }
+    if (err != ESP_OK) {
+        uart_driver_delete(port);
+        return err;
+    }
+
+    // TX and RX share the bus wire: open-drain output with the input path kept enabled
+    gpio_set_direction(pin, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_pull_mode(pin, GPIO_PULLUP_ONLY);
+    esp_rom_gpio_connect_out_signal(pin, UART_PERIPH_SIGNAL(port, SOC_UART_TX_PIN_IDX), false, false);
+    esp_rom_gpio_connect_in_signal(pin, UART_PERIPH_SIGNAL(port, SOC_UART_RX_PIN_IDX), false);
+
+    uart->port = port;
+    uart->pin = pin;
+    uart->bus.reset = onewire_uart_reset;
+    uart->bus.write_bit = onewire_uart_write_bit;
+    uart->bus.read_bit = onewire_uart_read_bit;
+    uart->bus.write_bytes = onewire_uart_write_bytes;
+    uart->bus.read_bytes = onewire_uart_read_bytes;
+
+    ESP_LOGI(TAG, "1-Wire on UART%d, GPIO %d", port, pin);
+    return ESP_OK;
+}
@@ -0,0 +1,118 @@
+#include "power_mode.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_freertos_hooks.h"
+#include "esp_log.h"
+#include "esp_pm.h"
+#include "esp_timer.h"
+#include "sched_task.h"
+#include "teleplot_udp.h"
+
+static const char *POWER_TAG = "power";
+
+// Przerwania ticka - liczone tak samo w obu trybach; przy tickless idle
+// CPU śpi bez ticków, więc spadek tej liczby to mniej wybudzeń
+static volatile uint32_t s_tick_count;
+
+static void IRAM_ATTR power_tick_hook(void) {
+    s_tick_count++;
+}
+
+#if POWER_LOW_POWER_MODE && CONFIG_PM_LIGHT_SLEEP_CALLBACKS
+// Wyjścia z light sleep (wywołanie zwrotne przy wyłączonych przerwaniach)
+static volatile uint32_t s_sleep_count;
+
+static esp_err_t IRAM_ATTR power_sleep_exit_cb(int64_t sleep_time_us, void *arg) {
+    s_sleep_count++;
+    return ESP_OK;
+}
+#endif
+
+// Raport: różnice liczników od poprzedniego wywołania
+static void power_report_job(void *arg) {
+    static int64_t last_us;
+    static uint32_t last_tick_count;
+    static uint32_t last_sched_wakeups;
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    static uint32_t last_idle;
+#endif
+#if POWER_LOW_POWER_MODE && CONFIG_PM_LIGHT_SLEEP_CALLBACKS
+    static uint32_t last_sleep_count;
+    uint32_t sleep_count = s_sleep_count;
+#endif
+
+    int64_t now_us = esp_timer_get_time();
+    uint32_t tick_count = s_tick_count;
+    uint32_t sched_wakeups = sched_get_wakeups();
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    // Licznik czasu wątku IDLE w us (esp_timer); light sleep odbywa się w IDLE,
+    // więc w obu trybach "aktywny" znaczy to samo: CPU wykonuje inne wątki
+    uint32_t idle = ulTaskGetIdleRunTimeCounter();
+#endif
+
+    if (last_us != 0) {
+        float elapsed_s = (now_us - last_us) / 1e6f;
+        float ticks_s = (tick_count - last_tick_count) / elapsed_s;
+        float sched_s = (sched_wakeups - last_sched_wakeups) / elapsed_s;
+        ESP_LOGI(POWER_TAG, "przerwania ticka %.1f/s, wybudzenia planisty %.1f/s", ticks_s, sched_s);
+        teleplot_publish("power_ticks_s", ticks_s);
+
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        // Różnica uint32_t jest odporna na przepełnienie licznika
+        float idle_s = (uint32_t)(idle - last_idle) / 1e6f;
+        float awake_pct = 100.0f * (1.0f - idle_s / elapsed_s);
+        if (awake_pct < 0.0f) {
+            awake_pct = 0.0f;
+        }
+        ESP_LOGI(POWER_TAG, "aktywny %.1f%%", awake_pct);
+        teleplot_publish("power_awake_pct", awake_pct);
+#endif
+
+#if POWER_LOW_POWER_MODE && CONFIG_PM_LIGHT_SLEEP_CALLBACKS
+        float wakeups_s = (sleep_count - last_sleep_count) / elapsed_s;
+        ESP_LOGI(POWER_TAG, "wyjścia z light sleep %.1f/s", wakeups_s);
+        teleplot_publish("power_wakeups_s", wakeups_s);
+#endif
+    }
+
+    last_us = now_us;
+    last_tick_count = tick_count;
+    last_sched_wakeups = sched_wakeups;
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    last_idle = idle;
+#endif
+#if POWER_LOW_POWER_MODE && CONFIG_PM_LIGHT_SLEEP_CALLBACKS
+    last_sleep_count = sleep_count;
+#endif
+}
+
+void power_mode_init(void) {
+#if POWER_LOW_POWER_MODE
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = POWER_MAX_FREQ_MHZ,
+        .min_freq_mhz = POWER_MIN_FREQ_MHZ,
+        .light_sleep_enable = true,
+    };
+    esp_err_t err = esp_pm_configure(&pm_config);
+    if (err != ESP_OK) {
+        ESP_LOGE(POWER_TAG, "esp_pm_configure: %s (CONFIG_PM_ENABLE?)", esp_err_to_name(err));
+    }
+
+#if CONFIG_PM_LIGHT_SLEEP_CALLBACKS
+    esp_pm_sleep_cbs_register_config_t cbs = {
+        .exit_cb = power_sleep_exit_cb,
+    };
+    esp_pm_light_sleep_register_cbs(&cbs);
+#endif
+
+    // Wszystkie zadania okresowe budzą CPU w tych samych oknach
+    sched_set_window(POWER_WAKE_WINDOW_MS);
+    ESP_LOGI(POWER_TAG, "Tryb oszczędny: light sleep, %d-%d MHz, okna %d ms, DTIM %d",
+             POWER_MIN_FREQ_MHZ, POWER_MAX_FREQ_MHZ, POWER_WAKE_WINDOW_MS, POWER_WIFI_LISTEN_INTERVAL);
+#endif
+
+    esp_register_freertos_tick_hook(power_tick_hook);
+    sched_add("power_report", POWER_REPORT_PERIOD_MS, POWER_REPORT_PERIOD_MS / 10, power_report_job, NULL);
+}
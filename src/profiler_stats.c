@@ -0,0 +1,45 @@
+#include "profiler_stats.h"
+
+#include <stdio.h>
+#include <string.h>
+
+uint32_t profiler_begin(profiler_t *prof, uint32_t total) {
+    uint32_t delta = prof->primed ? total - prof->last_total : 0;
+    prof->last_total = total;
+    prof->primed = true;
+    return delta;
+}
+
+profiler_task_t *profiler_task(profiler_t *prof, const char *name) {
+    for (int i = 0; i < prof->count; i++) {
+        if (strncmp(prof->tasks[i].task, name, PROFILER_TASK_NAME_MAX - 1) == 0) {
+            return &prof->tasks[i];
+        }
+    }
+    if (prof->count >= PROFILER_MAX_TASKS) {
+        return NULL;
+    }
+
+    profiler_task_t *task = &prof->tasks[prof->count++];
+    memset(task, 0, sizeof(*task));
+    snprintf(task->task, sizeof(task->task), "%s", name);
+    snprintf(task->cpu_channel, sizeof(task->cpu_channel), "sys.cpu.%.*s", PROFILER_TASK_NAME_MAX - 1, name);
+    snprintf(task->stack_channel, sizeof(task->stack_channel), "sys.stack.%.*s", PROFILER_TASK_NAME_MAX - 1, name);
+    return task;
+}
+
+float profiler_cpu_percent(profiler_task_t *task, uint32_t runtime, uint32_t total_delta, int cores) {
+    uint32_t delta = runtime - task->last_runtime;
+    bool primed = task->primed;
+    task->last_runtime = runtime;
+    task->primed = true;
+    if (!primed || total_delta == 0) {
+        return -1.0f;
+    }
+
+    // Wątek o tej samej nazwie utworzony na nowo ma licznik od zera
+    if (delta > total_delta * (uint32_t)cores) {
+        delta = runtime < total_delta * (uint32_t)cores ? runtime : total_delta * (uint32_t)cores;
+    }
+    return 100.0f * delta / ((float)total_delta * cores);
+}
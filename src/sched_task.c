@@ -0,0 +1,112 @@
+#include "sched_task.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *SCHED_TAG = "sched";
+
+static job_sched_t s_sched;
+static portMUX_TYPE s_sched_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t s_sched_task;
+static esp_timer_handle_t s_wake_timer;
+
+// Budzi wątek planisty - po nowym lub wznowionym zadaniu i z timera
+static void sched_wake(void) {
+    if (s_sched_task) {
+        xTaskNotifyGive(s_sched_task);
+    }
+}
+
+static void sched_timer_cb(void *arg) {
+    sched_wake();
+}
+
+int sched_add(const char *name, uint32_t period_ms, uint32_t slack_ms, job_fn_t fn, void *arg) {
+    portENTER_CRITICAL(&s_sched_lock);
+    int id = job_sched_add(&s_sched, name, period_ms, slack_ms, fn, arg);
+    portEXIT_CRITICAL(&s_sched_lock);
+    if (id < 0) {
+        ESP_LOGE(SCHED_TAG, "Nie można dodać zadania %s", name);
+        return -1;
+    }
+    sched_wake();
+    return id;
+}
+
+void sched_set_enabled(int id, bool enabled) {
+    job_sched_set_enabled(&s_sched, id, enabled);
+    sched_wake();
+}
+
+void sched_set_window(uint32_t window_ms) {
+    job_sched_set_window(&s_sched, window_ms);
+}
+
+uint32_t sched_get_wakeups(void) {
+    return s_sched.wakeups;
+}
+
+bool sched_get_stats(int id, const char **name, job_stats_t *stats) {
+    if (id < 0 || id >= job_sched_count(&s_sched)) {
+        return false;
+    }
+    // Statystyki zmienia tylko wątek planisty bez blokady - kopia z innego
+    // wątku może rozjechać się o jedno wywołanie, co dla raportów wystarcza
+    *name = s_sched.jobs[id].name;
+    *stats = s_sched.jobs[id].stats;
+    return true;
+}
+
+// Okresowy raport: średni i maksymalny czas wykonania oraz jitter każdego zadania
+static void sched_report_job(void *arg) {
+    int count = job_sched_count(&s_sched);
+    for (int i = 0; i < count; i++) {
+        const job_stats_t *stats = &s_sched.jobs[i].stats;
+        if (stats->runs == 0) {
+            continue;
+        }
+        ESP_LOGI(SCHED_TAG, "%-14s runs %6u  run avg %5u max %6u us  jitter avg %5u max %6u us  skipped %u",
+                 s_sched.jobs[i].name, (unsigned)stats->runs,
+                 (unsigned)(stats->run_total_us / stats->runs), (unsigned)stats->run_max_us,
+                 (unsigned)(stats->jitter_total_us / stats->runs), (unsigned)stats->jitter_max_us,
+                 (unsigned)stats->skipped);
+    }
+}
+
+static void sched_task(void *parameter) {
+    while (1) {
+        int64_t next_us = job_sched_run_due(&s_sched, esp_timer_get_time);
+
+        // Jeden timer na najbliższy termin; powiadomienie z sched_add() może przyjść wcześniej
+        esp_timer_stop(s_wake_timer);
+        if (next_us != INT64_MAX) {
+            int64_t delay_us = next_us - esp_timer_get_time();
+            esp_timer_start_once(s_wake_timer, delay_us > 0 ? delay_us : 0);
+        }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+void sched_start(void) {
+    const esp_timer_create_args_t timer_args = {
+        .callback = sched_timer_cb,
+        .name = "sched_wake",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_wake_timer));
+
+    sched_add("sched_report", SCHED_REPORT_PERIOD_MS, SCHED_REPORT_PERIOD_MS / 10, sched_report_job, NULL);
+
+    BaseType_t result = xTaskCreate(
+        sched_task,             // Funkcja wątku
+        "Sched",                // Nazwa wątku
+        SCHED_TASK_STACK_SIZE,  // Rozmiar stosu w bajtach
+        NULL,                   // Parametry
+        SCHED_TASK_PRIORITY,    // Priorytet
+        &s_sched_task           // Handle wątku
+    );
+    if (result != pdPASS) {
+        ESP_LOGE(SCHED_TAG, "Nie można utworzyć wątku planisty");
+    }
+}
@@ -0,0 +1,55 @@
+#include "ssd1306_cmd.h"
+
+// Power-up configuration, sent as one command stream
+static const uint8_t ssd1306_init_sequence[] = {
+    SSD1306_SET_DISPLAY_OFF,
+    SSD1306_SET_DISPLAY_CLK_DIV, 0x80,
+    SSD1306_SET_MULTIPLEX_RATIO, 0x3F,
+    SSD1306_SET_DISPLAY_OFFSET, 0x00,
+    SSD1306_SET_START_LINE | 0x00,
+    SSD1306_SET_CHARGE_PUMP, 0x14,
+    SSD1306_SET_MEMORY_ADDR_MODE, 0x00,     // Horizontal addressing
+    SSD1306_SET_SEGMENT_REMAP_OP,
+    SSD1306_SET_COM_SCAN_DIR_OP,
+    SSD1306_SET_COM_PINS_HW_CFG, 0x12,
+    SSD1306_SET_CONTRAST_CTRL, 0xCF,
+    SSD1306_SET_PRECHARGE, 0xF1,
+    SSD1306_SET_VCOM_DESELECT, 0x40,
+    SSD1306_SET_ENTIRE_DISPLAY_ON_RESUME,
+    SSD1306_SET_NORMAL_DISPLAY,
+    SSD1306_SET_DISPLAY_ON,
+};
+
+int ssd1306_cmd_send(const ssd1306_bus_t *bus, const uint8_t *cmds, size_t len)
+{
+    return bus->write(bus->ctx, SSD1306_CONTROL_CMD_STREAM, cmds, len);
+}
+
+int ssd1306_cmd_init_panel(const ssd1306_bus_t *bus)
+{
+    return ssd1306_cmd_send(bus, ssd1306_init_sequence, sizeof(ssd1306_init_sequence));
+}
+
+int ssd1306_cmd_set_window(const ssd1306_bus_t *bus, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1)
+{
+    const uint8_t window[] = {
+        SSD1306_SET_COLUMN_RANGE, x0, x1,
+        SSD1306_SET_PAGE_RANGE, page0, page1,
+    };
+    return ssd1306_cmd_send(bus, window, sizeof(window));
+}
+
+int ssd1306_cmd_scroll_left(const ssd1306_bus_t *bus, uint8_t page0, uint8_t page1, uint8_t x0, uint8_t x1)
+{
+    const uint8_t scroll[] = {
+        SSD1306_DEACTIVATE_SCROLL,
+        SSD1306_CONTENT_SCROLL_LEFT, 0x00, page0, 0x01, page1, x0, x1,
+    };
+    return ssd1306_cmd_send(bus, scroll, sizeof(scroll));
+}
+
+int ssd1306_cmd_set_start_line(const ssd1306_bus_t *bus, uint8_t line)
+{
+    const uint8_t cmd = SSD1306_SET_START_LINE | (line & 0x3F);
+    return ssd1306_cmd_send(bus, &cmd, 1);
+}
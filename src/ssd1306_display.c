@@ -2,136 +2,73 @@
 #include "driver/i2c.h"
 #include "esp_log.h"
 #include "esp_err.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include <stdatomic.h>
 #include <string.h>
 #include <stdio.h>
 #include <time.h>
 #include <sys/time.h>
+#if SSD1306_SNAPSHOT_ENABLE
+#include "esp_timer.h"
+#include "host_ip.h"
+#include "ssd1306_snapshot.h"
+#include <errno.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#endif
 
 static const char *TAG = "SSD1306";
 
-// Display buffer - each bit represents one pixel
-static uint8_t display_buffer[SSD1306_WIDTH * SSD1306_HEIGHT / 8];
-
-// Simple 8x8 font (basic ASCII characters)
-static const uint8_t font8x8[96][8] = {
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' ' (space)
-    {0x18, 0x3C, 0x3C, 0x18, 0x18, 0x00, 0x18, 0x00}, // '!'
-    {0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // '"'
-    {0x36, 0x36, 0x7F, 0x36, 0x7F, 0x36, 0x36, 0x00}, // '#'
-    {0x0C, 0x3E, 0x03, 0x1E, 0x30, 0x1F, 0x0C, 0x00}, // '$'
-    {0x00, 0x63, 0x33, 0x18, 0x0C, 0x66, 0x63, 0x00}, // '%'
-    {0x1C, 0x36, 0x1C, 0x6E, 0x3B, 0x33, 0x6E, 0x00}, // '&'
-    {0x06, 0x06, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00}, // '''
-    {0x18, 0x0C, 0x06, 0x06, 0x06, 0x0C, 0x18, 0x00}, // '('
-    {0x06, 0x0C, 0x18, 0x18, 0x18, 0x0C, 0x06, 0x00}, // ')'
-    {0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00}, // '*'
-    {0x00, 0x0C, 0x0C, 0x3F, 0x0C, 0x0C, 0x00, 0x00}, // '+'
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x06, 0x00}, // ','
-    {0x00, 0x00, 0x00, 0x3F, 0x00, 0x00, 0x00, 0x00}, // '-'
-    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00}, // '.'
-    {0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x01, 0x00}, // '/'
-    {0x3E, 0x63, 0x73, 0x7B, 0x6F, 0x67, 0x3E, 0x00}, // '0'
-    {0x0C, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x00}, // '1'
-    {0x1E, 0x33, 0x30, 0x1C, 0x06, 0x33, 0x3F, 0x00}, // '2'
-    {0x1E, 0x33, 0x30, 0x1C, 0x30, 0x33, 0x1E, 0x00}, // '3'
-    {0x38, 0x3C, 0x36, 0x33, 0x7F, 0x30, 0x78, 0x00}, // '4'
-    {0x3F, 0x03, 0x1F, 0x30, 0x30, 0x33, 0x1E, 0x00}, // '5'
-    {0x1C, 0x06, 0x03, 0x1F, 0x33, 0x33, 0x1E, 0x00}, // '6'
-    {0x3F, 0x33, 0x30, 0x18, 0x0C, 0x0C, 0x0C, 0x00}, // '7'
-    {0x1E, 0x33, 0x33, 0x1E, 0x33, 0x33, 0x1E, 0x00}, // '8'
-    {0x1E, 0x33, 0x33, 0x3E, 0x30, 0x18, 0x0E, 0x00}, // '9'
-    {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x0C, 0x00}, // ':'
-    {0x00, 0x0C, 0x0C, 0x00, 0x00, 0x0C, 0x06, 0x00}, // ';'
-    {0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x00}, // '<'
-    {0x00, 0x00, 0x3F, 0x00, 0x00, 0x3F, 0x00, 0x00}, // '='
-    {0x06, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0x06, 0x00}, // '>'
-    {0x1E, 0x33, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x00}, // '?'
-    {0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x03, 0x1E, 0x00}, // '@'
-    {0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00}, // 'A'
-    {0x3F, 0x66, 0x66, 0x3E, 0x66, 0x66, 0x3F, 0x00}, // 'B'
-    {0x3C, 0x66, 0x03, 0x03, 0x03, 0x66, 0x3C, 0x00}, // 'C'
-    {0x1F, 0x36, 0x66, 0x66, 0x66, 0x36, 0x1F, 0x00}, // 'D'
-    {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x46, 0x7F, 0x00}, // 'E'
-    {0x7F, 0x46, 0x16, 0x1E, 0x16, 0x06, 0x0F, 0x00}, // 'F'
-    {0x3C, 0x66, 0x03, 0x03, 0x73, 0x66, 0x7C, 0x00}, // 'G'
-    {0x33, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x33, 0x00}, // 'H'
-    {0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // 'I'
-    {0x78, 0x30, 0x30, 0x30, 0x33, 0x33, 0x1E, 0x00}, // 'J'
-    {0x67, 0x66, 0x36, 0x1E, 0x36, 0x66, 0x67, 0x00}, // 'K'
-    {0x0F, 0x06, 0x06, 0x06, 0x46, 0x66, 0x7F, 0x00}, // 'L'
-    {0x63, 0x77, 0x7F, 0x7F, 0x6B, 0x63, 0x63, 0x00}, // 'M'
-    {0x63, 0x67, 0x6F, 0x7B, 0x73, 0x63, 0x63, 0x00}, // 'N'
-    {0x1C, 0x36, 0x63, 0x63, 0x63, 0x36, 0x1C, 0x00}, // 'O'
-    {0x3F, 0x66, 0x66, 0x3E, 0x06, 0x06, 0x0F, 0x00}, // 'P'
-    {0x1E, 0x33, 0x33, 0x33, 0x3B, 0x1E, 0x38, 0x00}, // 'Q'
-    {0x3F, 0x66, 0x66, 0x3E, 0x36, 0x66, 0x67, 0x00}, // 'R'
-    {0x1E, 0x33, 0x07, 0x0E, 0x38, 0x33, 0x1E, 0x00}, // 'S'
-    {0x3F, 0x2D, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x00}, // 'T'
-    {0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3F, 0x00}, // 'U'
-    {0x33, 0x33, 0x33, 0x33, 0x33, 0x1E, 0x0C, 0x00}, // 'V'
-    {0x63, 0x63, 0x63, 0x6B, 0x7F, 0x77, 0x63, 0x00}, // 'W'
-    {0x63, 0x63, 0x36, 0x1C, 0x1C, 0x36, 0x63, 0x00}, // 'X'
-    {0x33, 0x33, 0x33, 0x1E, 0x0C, 0x0C, 0x1E, 0x00}, // 'Y'
-    {0x7F, 0x63, 0x31, 0x18, 0x4C, 0x66, 0x7F, 0x00}, // 'Z'
-};
-
-// SSD1306 command definitions
-#define SSD1306_SET_CONTRAST_CTRL               0x81
-#define SSD1306_SET_ENTIRE_DISPLAY_ON_RESUME    0xA4
-#define SSD1306_SET_ENTIRE_DISPLAY_ON            0xA5
-#define SSD1306_SET_NORMAL_DISPLAY               0xA6
-#define SSD1306_SET_INVERSE_DISPLAY              0xA7
-#define SSD1306_SET_DISPLAY_OFF                  0xAE
-#define SSD1306_SET_DISPLAY_ON                   0xAF
-#define SSD1306_SET_DISPLAY_OFFSET               0xD3
-#define SSD1306_SET_COM_PINS_HW_CFG              0xDA
-#define SSD1306_SET_VCOM_DESELECT                0xDB
-#define SSD1306_SET_DISPLAY_CLK_DIV              0xD5
-#define SSD1306_SET_PRECHARGE                    0xD9
-#define SSD1306_SET_MULTIPLEX_RATIO              0xA8
-#define SSD1306_SET_LOW_COLUMN                   0x00
-#define SSD1306_SET_HIGH_COLUMN                  0x10
-#define SSD1306_SET_START_LINE                   0x40
-#define SSD1306_SET_MEMORY_ADDR_MODE             0x20
-#define SSD1306_SET_COLUMN_RANGE                 0x21
-#define SSD1306_SET_PAGE_RANGE                   0x22
-#define SSD1306_SET_COM_SCAN_DIR                 0xC0
-#define SSD1306_SET_COM_SCAN_DIR_OP              0xC8
-#define SSD1306_SET_SEGMENT_REMAP                0xA0
-#define SSD1306_SET_SEGMENT_REMAP_OP             0xA1
-#define SSD1306_SET_CHARGE_PUMP                  0x8D
-#define SSD1306_EXTERNAL_VCC                     0x1
-#define SSD1306_INTERNAL_VCC                     0x2
+// Double buffering: drawing goes into the back buffer, the flush task owns the
+// front buffer while it is on the wire. Both track dirty regions so only
+// changed columns go over I2C.
+static ssd1306_fb_t s_fb;        // Back buffer
+static ssd1306_fb_t s_front_fb;  // Front buffer
+static SemaphoreHandle_t s_front_free;
+static TaskHandle_t s_flush_task;
 
 // I2C driver handle
 static i2c_port_t i2c_num = I2C_NUM_0;
 
-// Send command to SSD1306
-static esp_err_t ssd1306_write_command(uint8_t cmd)
+// One I2C transaction: address, control byte, then the whole command or data stream
+static int ssd1306_i2c_write(void *ctx, uint8_t control, const uint8_t *bytes, size_t len)
 {
     i2c_cmd_handle_t cmd_handle = i2c_cmd_link_create();
     i2c_master_start(cmd_handle);
     i2c_master_write_byte(cmd_handle, (SSD1306_I2C_ADDRESS << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd_handle, 0x80, true); // Command mode
-    i2c_master_write_byte(cmd_handle, cmd, true);
+    i2c_master_write_byte(cmd_handle, control, true);
+    i2c_master_write(cmd_handle, bytes, len, true);
     i2c_master_stop(cmd_handle);
     esp_err_t ret = i2c_master_cmd_begin(i2c_num, cmd_handle, pdMS_TO_TICKS(1000));
     i2c_cmd_link_delete(cmd_handle);
     return ret;
 }
 
-// Send data to SSD1306
-static esp_err_t ssd1306_write_data(uint8_t* data, size_t data_len)
+// Waits between hardware scroll steps; only the flush task calls this
+static void ssd1306_delay_ms(void *ctx, uint32_t ms)
 {
-    i2c_cmd_handle_t cmd_handle = i2c_cmd_link_create();
-    i2c_master_start(cmd_handle);
-    i2c_master_write_byte(cmd_handle, (SSD1306_I2C_ADDRESS << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd_handle, 0x40, true); // Data mode
-    i2c_master_write(cmd_handle, data, data_len, true);
-    i2c_master_stop(cmd_handle);
-    esp_err_t ret = i2c_master_cmd_begin(i2c_num, cmd_handle, pdMS_TO_TICKS(1000));
-    i2c_cmd_link_delete(cmd_handle);
-    return ret;
+    vTaskDelay(pdMS_TO_TICKS(ms) > 0 ? pdMS_TO_TICKS(ms) : 1);
+}
+
+static const ssd1306_bus_t s_bus = {
+    .write = ssd1306_i2c_write,
+    .delay_ms = ssd1306_delay_ms,
+};
+
+// Flush task - sends each swapped frame while drawing continues in the back buffer
+static void ssd1306_flush_task(void *parameter)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        esp_err_t ret = ssd1306_fb_flush(&s_front_fb, &s_bus);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Display flush failed: %s", esp_err_to_name(ret));
+        }
+        xSemaphoreGive(s_front_free);
+    }
 }
 
 // Initialize I2C
@@ -164,35 +101,24 @@ esp_err_t ssd1306_init(void)
 
     ESP_LOGI(TAG, "I2C initialized successfully");
 
-    // SSD1306 initialization sequence
-    ssd1306_write_command(SSD1306_SET_DISPLAY_OFF);
-    ssd1306_write_command(SSD1306_SET_DISPLAY_CLK_DIV);
-    ssd1306_write_command(0x80);
-    ssd1306_write_command(SSD1306_SET_MULTIPLEX_RATIO);
-    ssd1306_write_command(0x3F);
-    ssd1306_write_command(SSD1306_SET_DISPLAY_OFFSET);
-    ssd1306_write_command(0x00);
-    ssd1306_write_command(SSD1306_SET_START_LINE | 0x00);
-    ssd1306_write_command(SSD1306_SET_CHARGE_PUMP);
-    ssd1306_write_command(0x14);
-    ssd1306_write_command(SSD1306_SET_MEMORY_ADDR_MODE);
-    ssd1306_write_command(0x00);
-    ssd1306_write_command(SSD1306_SET_SEGMENT_REMAP_OP);
-    ssd1306_write_command(SSD1306_SET_COM_SCAN_DIR_OP);
-    ssd1306_write_command(SSD1306_SET_COM_PINS_HW_CFG);
-    ssd1306_write_command(0x12);
-    ssd1306_write_command(SSD1306_SET_CONTRAST_CTRL);
-    ssd1306_write_command(0xCF);
-    ssd1306_write_command(SSD1306_SET_PRECHARGE);
-    ssd1306_write_command(0xF1);
-    ssd1306_write_command(SSD1306_SET_VCOM_DESELECT);
-    ssd1306_write_command(0x40);
-    ssd1306_write_command(SSD1306_SET_ENTIRE_DISPLAY_ON_RESUME);
-    ssd1306_write_command(SSD1306_SET_NORMAL_DISPLAY);
-    ssd1306_write_command(SSD1306_SET_DISPLAY_ON);
-
-    // Clear display buffer
-    ssd1306_clear_display();
+    // SSD1306 initialization sequence, one transaction
+    ret = ssd1306_cmd_init_panel(&s_bus);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "SSD1306 not responding: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    s_front_free = xSemaphoreCreateBinary();
+    if (s_front_free == NULL ||
+        xTaskCreate(ssd1306_flush_task, "SSD1306_Flush", 3072, NULL, 5, &s_flush_task) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create display flush task");
+        return ESP_ERR_NO_MEM;
+    }
+    xSemaphoreGive(s_front_free);
+
+    // Clear display buffers; the first flush overwrites the whole panel RAM
+    ssd1306_fb_init(&s_front_fb);
+    ssd1306_fb_init(&s_fb);
     ssd1306_display();
 
     ESP_LOGI(TAG, "SSD1306 initialized successfully");
@@ -202,88 +128,210 @@ esp_err_t ssd1306_init(void)
 // Clear display buffer
 void ssd1306_clear_display(void)
 {
-    memset(display_buffer, 0, sizeof(display_buffer));
+    ssd1306_fb_clear(&s_fb);
 }
 
-// Update display with buffer content
+// Hand the back buffer to the flush task and return
 void ssd1306_display(void)
 {
-    ssd1306_write_command(SSD1306_SET_COLUMN_RANGE);
-    ssd1306_write_command(0);
-    ssd1306_write_command(127);
-    ssd1306_write_command(SSD1306_SET_PAGE_RANGE);
-    ssd1306_write_command(0);
-    ssd1306_write_command(7);
-    ssd1306_write_data(display_buffer, sizeof(display_buffer));
+    // Only waits if the previous frame is still on the wire
+    xSemaphoreTake(s_front_free, portMAX_DELAY);
+    ssd1306_fb_copy_frame(&s_front_fb, &s_fb);
+    xTaskNotifyGive(s_flush_task);
+}
+
+// Block until the last swapped frame has reached the panel
+void ssd1306_wait_flush(void)
+{
+    xSemaphoreTake(s_front_free, portMAX_DELAY);
+    xSemaphoreGive(s_front_free);
 }
 
 // Set pixel in display buffer
 void ssd1306_set_pixel(int x, int y, int color)
 {
-    if (x < 0 || x >= SSD1306_WIDTH || y < 0 || y >= SSD1306_HEIGHT) {
-        return;
-    }
-    
-    int byte_idx = x + (y / 8) * SSD1306_WIDTH;
-    int bit_idx = y % 8;
-    
-    if (color) {
-        display_buffer[byte_idx] |= (1 << bit_idx);
-    } else {
-        display_buffer[byte_idx] &= ~(1 << bit_idx);
-    }
+    ssd1306_fb_set_pixel(&s_fb, x, y, color);
 }
 
 // Write text to display buffer
 void ssd1306_write_text(int x, int y, const char* text)
 {
-    int text_x = x;
-    int text_y = y;
-    
-    for (int i = 0; text[i] != '\0'; i++) {
-        char c = text[i];
-        
-        // Handle newline
-        if (c == '\n') {
-            text_x = x;
-            text_y += 8;
-            continue;
-        }
-        
-        // Check bounds
-        if (text_x + 8 > SSD1306_WIDTH) {
-            text_x = x;
-            text_y += 8;
-        }
-        if (text_y + 8 > SSD1306_HEIGHT) {
-            break;
-        }
-        
-        // Get character font data (ASCII 32-127)
-        if (c >= 32 && c <= 127) {
-            const uint8_t* font_data = font8x8[c - 32];
-            
-            // Draw character
-            for (int row = 0; row < 8; row++) {
-                uint8_t font_row = font_data[row];
-                for (int col = 0; col < 8; col++) {
-                    if (font_row & (1 << col)) {
-                        ssd1306_set_pixel(text_x + col, text_y + row, 1);
-                    }
-                }
-            }
+    ssd1306_fb_write_text(&s_fb, x, y, text);
+}
+
+// Write one line of text with any generated font
+int ssd1306_draw_text(int x, int y, const char* text, const ssd1306_font_t *font)
+{
+    return ssd1306_fb_draw_text(&s_fb, x, y, text, font);
+}
+
+// Line between two points
+void ssd1306_draw_line(int x0, int y0, int x1, int y1, int color)
+{
+    ssd1306_fb_line(&s_fb, x0, y0, x1, y1, color);
+}
+
+// Filled rectangle, color 0 clears it
+void ssd1306_fill_rect(int x, int y, int w, int h, int color)
+{
+    ssd1306_fb_fill_rect(&s_fb, x, y, w, h, color);
+}
+
+// Move a rectangle left; page-aligned areas are shifted by the panel itself
+void ssd1306_scroll_left(int x, int y, int w, int h, int columns)
+{
+    ssd1306_fb_scroll_left(&s_fb, x, y, w, h, columns);
+}
+
+// Scroll the whole picture up via the panel's start line
+void ssd1306_scroll_up(int rows)
+{
+    ssd1306_fb_scroll_up(&s_fb, rows);
+}
+
+// Bring a strip chart up to date; only its new columns are drawn
+void ssd1306_draw_sparkline(ssd1306_sparkline_t *chart)
+{
+    ssd1306_sparkline_draw(chart, &s_fb);
+}
+
+// Display service: other tasks post commands, the LCD task is the only one
+// that draws. Posting copies the command into the queue and never blocks.
+#define DISPLAY_QUEUE_LENGTH    16
+
+static QueueHandle_t s_cmd_queue;
+static display_sources_t s_sources;     // LCD task only
+static atomic_uint s_dropped_cmds;     // Posted from any task
+
+static bool ssd1306_post(const display_cmd_t *cmd)
+{
+    if (s_cmd_queue == NULL || xQueueSend(s_cmd_queue, cmd, 0) != pdTRUE) {
+        atomic_fetch_add_explicit(&s_dropped_cmds, 1, memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+// Publish a value from any task; widgets bound to the source re-render if their text changes
+bool ssd1306_publish(display_source_t source, display_value_t value)
+{
+    display_cmd_t cmd = {
+        .type = DISPLAY_CMD_VALUE,
+        .update = { .source = source, .value = value },
+    };
+    return ssd1306_post(&cmd);
+}
+
+// One line of text from any task; the box of w pixels is cleared first (0 = text width)
+bool ssd1306_post_text(int x, int y, int w, const char *text, const ssd1306_font_t *font)
+{
+    display_cmd_t cmd = {
+        .type = DISPLAY_CMD_TEXT,
+        .x = x,
+        .y = y,
+        .w = w,
+        .text = { .font = font },
+    };
+    snprintf(cmd.text.text, sizeof(cmd.text.text), "%s", text);
+    return ssd1306_post(&cmd);
+}
+
+// Fill (color 1) or clear (color 0) a rectangle from any task
+bool ssd1306_post_fill(int x, int y, int w, int h, int color)
+{
+    display_cmd_t cmd = {
+        .type = DISPLAY_CMD_FILL,
+        .x = x, .y = y, .w = w, .h = h,
+        .color = color,
+    };
+    return ssd1306_post(&cmd);
+}
+
+// Resend a region of the panel from any task
+bool ssd1306_post_invalidate(int x, int y, int w, int h)
+{
+    display_cmd_t cmd = {
+        .type = DISPLAY_CMD_INVALIDATE,
+        .x = x, .y = y, .w = w, .h = h,
+    };
+    return ssd1306_post(&cmd);
+}
+
+// Commands lost because the queue was full
+uint32_t ssd1306_dropped_commands(void)
+{
+    return atomic_load_explicit(&s_dropped_cmds, memory_order_relaxed);
+}
+
+// Update the clock source; returns ms until the next second starts
+static uint32_t lcd_update_clock(void)
+{
+    struct timeval tv;
+    struct tm timeinfo;
+    gettimeofday(&tv, NULL);
+    localtime_r(&tv.tv_sec, &timeinfo);
+
+    int32_t seconds = timeinfo.tm_hour * 3600 + timeinfo.tm_min * 60 + timeinfo.tm_sec;
+    display_sources_update(&s_sources, DISPLAY_SOURCE_CLOCK, display_value_integer(seconds));
+    return 1000 - tv.tv_usec / 1000;
+}
+
+#if SSD1306_SNAPSHOT_ENABLE
+// Remote mirror: a run-length coded copy of the back buffer goes to HOST_IP
+// when it changed, at most once per SSD1306_SNAPSHOT_MIN_INTERVAL_MS. Sent
+// from the LCD task, so the buffer is never read mid-draw.
+static int s_snapshot_fd = -1;
+static uint16_t s_snapshot_seq;
+static uint32_t s_snapshot_hash;
+static int64_t s_snapshot_last_us;
+
+static void lcd_send_snapshot(void)
+{
+    if (!s_sources.values[DISPLAY_SOURCE_WIFI].valid) {
+        return;
+    }
+    int64_t now_us = esp_timer_get_time();
+    if (s_snapshot_last_us != 0 &&
+        now_us - s_snapshot_last_us < SSD1306_SNAPSHOT_MIN_INTERVAL_MS * 1000LL) {
+        return;
+    }
+    uint32_t hash = ssd1306_snapshot_hash(s_fb.buffer);
+    if (s_snapshot_last_us != 0 && hash == s_snapshot_hash) {
+        return;
+    }
+
+    if (s_snapshot_fd < 0) {
+        s_snapshot_fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_IP);
+        if (s_snapshot_fd < 0) {
+            ESP_LOGW(TAG, "Snapshot socket failed: errno %d", errno);
+            return;
         }
-        
-        text_x += 8;
     }
+
+    static uint8_t pkt[SSD1306_SNAPSHOT_MAX_SIZE];
+    size_t len = ssd1306_snapshot_encode(s_fb.buffer, s_snapshot_seq, pkt, sizeof(pkt));
+    struct sockaddr_in dest = {
+        .sin_family = AF_INET,
+        .sin_port = htons(SSD1306_SNAPSHOT_PORT),
+        .sin_addr.s_addr = inet_addr(HOST_IP),
+    };
+    // A full socket buffer just skips this snapshot; the next change resends the whole frame
+    if (sendto(s_snapshot_fd, pkt, len, MSG_DONTWAIT, (struct sockaddr *)&dest, sizeof(dest)) < 0) {
+        ESP_LOGD(TAG, "Snapshot not sent: errno %d", errno);
+        return;
+    }
+    s_snapshot_seq++;
+    s_snapshot_hash = hash;
+    s_snapshot_last_us = now_us;
+    ESP_LOGD(TAG, "Snapshot %u: %u bytes", s_snapshot_seq, (unsigned)len);
 }
+#endif
 
-// LCD display task - runs in separate thread
+// LCD display task - owns the back buffer; sleeps until a command arrives or the clock ticks
 static void lcd_display_task(void *parameter)
 {
-    int counter = 0;
-    int update_counter = 0;
-    
+    static display_screen_t screen;
+
     ESP_LOGI(TAG, "LCD display task started");
     
     // Initialize SSD1306
@@ -292,53 +340,53 @@ static void lcd_display_task(void *parameter)
         vTaskDelete(NULL);
         return;
     }
-    
+
+    // Static title, then one widget per source
+    ssd1306_write_text(0, 0, "ESP32 LCD Demo");
+    display_screen_init(&screen);
+    display_screen_add(&screen, 0, 16, &ssd1306_font_8x8, DISPLAY_SOURCE_CLOCK, display_format_clock);
+    display_screen_add(&screen, 0, 32, &ssd1306_font_8x8, DISPLAY_SOURCE_TEMPERATURE, display_format_temperature);
+    display_screen_add(&screen, 0, 48, &ssd1306_font_8x8, DISPLAY_SOURCE_WIFI, display_format_wifi);
+
+    bool drawn = true;  // Title
+    uint32_t next_second_ms = 0;
     while (1) {
-        // Clear display
-        ssd1306_clear_display();
-        
-        // Get current time
-        time_t now;
-        struct tm timeinfo;
-        time(&now);
-        localtime_r(&now, &timeinfo);
-        
-        char time_str[32];
-        char counter_str[32];
-        char status_str[32];
-        char update_str[32];
-        
-        // Format time string
-        strftime(time_str, sizeof(time_str), "%H:%M:%S", &timeinfo);
-        
-        // Format other strings
-        snprintf(counter_str, sizeof(counter_str), "Count: %d", counter);
-        snprintf(status_str, sizeof(status_str), "Status: RUNNING");
-        snprintf(update_str, sizeof(update_str), "Updates: %d", update_counter);
-        
-        // Write text to display
-        ssd1306_write_text(0, 0, "ESP32 LCD Demo");
-        ssd1306_write_text(0, 16, time_str);
-        ssd1306_write_text(0, 32, counter_str);
-        ssd1306_write_text(0, 48, status_str);
-        
-        // Update display
-        ssd1306_display();
-        
-        // Increment counters
-        counter++;
-        update_counter++;
-        
-        ESP_LOGI(TAG, "LCD updated - Counter: %d, Updates: %d", counter, update_counter);
-        
-        // Wait 2 seconds before next update
-        vTaskDelay(2000 / portTICK_PERIOD_MS);
+        // Wait for the first command or the next clock second, then drain the
+        // queue so a burst of updates costs one frame
+        display_cmd_t cmd;
+        TickType_t wait = pdMS_TO_TICKS(next_second_ms) + 1;
+        while (xQueueReceive(s_cmd_queue, &cmd, wait) == pdTRUE) {
+            drawn |= display_apply(&cmd, &s_sources, &s_fb);
+            wait = 0;
+        }
+
+        next_second_ms = lcd_update_clock();
+        uint32_t changed = s_sources.changed;
+        s_sources.changed = 0;
+        int redrawn = display_screen_render(&screen, s_sources.values, changed, &s_fb);
+        if (redrawn > 0 || drawn) {
+            ssd1306_display();
+            ESP_LOGD(TAG, "Redrew %d widget(s)", redrawn);
+        }
+        drawn = false;
+#if SSD1306_SNAPSHOT_ENABLE
+        lcd_send_snapshot();
+#endif
     }
 }
 
 // Start LCD display task
 void start_lcd_display_task(void)
 {
+    // Created before the task so producers started earlier can already post
+    if (s_cmd_queue == NULL) {
+        s_cmd_queue = xQueueCreate(DISPLAY_QUEUE_LENGTH, sizeof(display_cmd_t));
+        if (s_cmd_queue == NULL) {
+            ESP_LOGE(TAG, "Failed to create display command queue");
+            return;
+        }
+    }
+
     BaseType_t result = xTaskCreate(
         lcd_display_task,       // Function that implements the task
         "LCD_Display_Task",     // Text name for the task
@@ -353,4 +401,4 @@ void start_lcd_display_task(void)
     } else {
         ESP_LOGE(TAG, "Failed to create LCD display task");
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,664 @@
+#include "ssd1306_fb.h"
+#include <string.h>
+
+// Unchanged columns inside a dirty range are resent when there are fewer of
+// them than this: a second window costs about as much (command transaction,
+// data control byte, I2C addressing)
+#define SSD1306_FLUSH_SPLIT_GAP     10
+
+// Grow a page's dirty range to include columns x0..x1
+static inline void ssd1306_fb_extend_dirty(ssd1306_fb_t *fb, int page, int x0, int x1)
+{
+    if (x0 < fb->dirty_min[page]) {
+        fb->dirty_min[page] = x0;
+    }
+    if (x1 > fb->dirty_max[page]) {
+        fb->dirty_max[page] = x1;
+    }
+}
+
+static void ssd1306_fb_mark_clean(ssd1306_fb_t *fb)
+{
+    memset(fb->dirty_min, SSD1306_WIDTH, sizeof(fb->dirty_min));
+    memset(fb->dirty_max, 0, sizeof(fb->dirty_max));
+    memset(fb->stale_min, SSD1306_WIDTH, sizeof(fb->stale_min));
+    memset(fb->stale_max, 0, sizeof(fb->stale_max));
+}
+
+static void ssd1306_fb_mark_all_dirty(ssd1306_fb_t *fb)
+{
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        fb->dirty_min[page] = 0;
+        fb->dirty_max[page] = SSD1306_WIDTH - 1;
+    }
+}
+
+// Union of one column range over all pages, applied back to every page
+static void ssd1306_fb_spread_range(uint8_t *min, uint8_t *max)
+{
+    int x0 = SSD1306_WIDTH;
+    int x1 = 0;
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        if (min[page] < x0) {
+            x0 = min[page];
+        }
+        if (min[page] <= max[page] && max[page] > x1) {
+            x1 = max[page];
+        }
+    }
+    if (x0 <= x1) {
+        memset(min, x0, SSD1306_PAGES);
+        memset(max, x1, SSD1306_PAGES);
+    }
+}
+
+// After the picture moved vertically the dirty columns may sit on any page
+static void ssd1306_fb_spread_dirty(ssd1306_fb_t *fb)
+{
+    ssd1306_fb_spread_range(fb->dirty_min, fb->dirty_max);
+    ssd1306_fb_spread_range(fb->stale_min, fb->stale_max);
+}
+
+// Panel state is unknown (failed scroll command): resend everything
+static void ssd1306_fb_invalidate_shadow(ssd1306_fb_t *fb)
+{
+    fb->shadow_valid = false;
+    ssd1306_fb_mark_all_dirty(fb);
+}
+
+// Move a full-height image up by `rows`, wrapping the top rows to the bottom
+static void ssd1306_fb_rotate_up(uint8_t *image, int rows)
+{
+    rows &= SSD1306_HEIGHT - 1;
+    if (rows == 0) {
+        return;
+    }
+    for (int x = 0; x < SSD1306_WIDTH; x++) {
+        uint64_t column = 0;
+        for (int page = 0; page < SSD1306_PAGES; page++) {
+            column |= (uint64_t)image[page * SSD1306_WIDTH + x] << (page * 8);
+        }
+        column = (column >> rows) | (column << (SSD1306_HEIGHT - rows));
+        for (int page = 0; page < SSD1306_PAGES; page++) {
+            image[page * SSD1306_WIDTH + x] = (uint8_t)(column >> (page * 8));
+        }
+    }
+}
+
+// Move columns x0..x1 of pages page0..page1 left by one, wrapping like the panel's content scroll
+static void ssd1306_fb_rotate_left(uint8_t *image, int page0, int page1, int x0, int x1)
+{
+    for (int page = page0; page <= page1; page++) {
+        uint8_t *row = &image[page * SSD1306_WIDTH];
+        uint8_t first = row[x0];
+        memmove(&row[x0], &row[x0 + 1], x1 - x0);
+        row[x1] = first;
+    }
+}
+
+void ssd1306_fb_init(ssd1306_fb_t *fb)
+{
+    memset(fb->buffer, 0, sizeof(fb->buffer));
+    fb->shadow_valid = false;
+    fb->start_line = 0;
+    fb->panel_start_line = 0;   // Set by the init sequence
+    fb->hscroll.columns = 0;
+    fb->content_scroll = SSD1306_CONTENT_SCROLL_ENABLE;
+    ssd1306_fb_mark_clean(fb);
+    ssd1306_fb_mark_all_dirty(fb);
+}
+
+void ssd1306_fb_mark_dirty(ssd1306_fb_t *fb, int page, int x0, int x1)
+{
+    if (page < 0 || page >= SSD1306_PAGES) {
+        return;
+    }
+    if (x0 < 0) {
+        x0 = 0;
+    }
+    if (x1 >= SSD1306_WIDTH) {
+        x1 = SSD1306_WIDTH - 1;
+    }
+    if (x0 <= x1) {
+        ssd1306_fb_extend_dirty(fb, page, x0, x1);
+    }
+}
+
+void ssd1306_fb_clear(ssd1306_fb_t *fb)
+{
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        uint8_t *row = &fb->buffer[page * SSD1306_WIDTH];
+        int first = 0;
+        int last = SSD1306_WIDTH - 1;
+        while (first <= last && row[first] == 0) {
+            first++;
+        }
+        while (last >= first && row[last] == 0) {
+            last--;
+        }
+        if (first <= last) {
+            memset(&row[first], 0, last - first + 1);
+            ssd1306_fb_extend_dirty(fb, page, first, last);
+        }
+    }
+}
+
+void ssd1306_fb_set_pixel(ssd1306_fb_t *fb, int x, int y, int color)
+{
+    if (x < 0 || x >= SSD1306_WIDTH || y < 0 || y >= SSD1306_HEIGHT) {
+        return;
+    }
+
+    int page = y / 8;
+    uint8_t *byte = &fb->buffer[x + page * SSD1306_WIDTH];
+    uint8_t value = color ? (*byte | (1 << (y % 8))) : (*byte & ~(1 << (y % 8)));
+
+    if (value != *byte) {
+        *byte = value;
+        ssd1306_fb_extend_dirty(fb, page, x, x);
+    }
+}
+
+// Set (color != 0) or clear the mask bits in columns x0..x1 of one page.
+// Coordinates must already be clipped.
+static void ssd1306_fb_apply_mask(ssd1306_fb_t *fb, int page, int x0, int x1, uint8_t mask, int color)
+{
+    uint8_t *row = &fb->buffer[page * SSD1306_WIDTH];
+    int first = -1;
+    int last = -1;
+
+    for (int x = x0; x <= x1; x++) {
+        uint8_t value = color ? (row[x] | mask) : (row[x] & ~mask);
+        if (value != row[x]) {
+            row[x] = value;
+            if (first < 0) {
+                first = x;
+            }
+            last = x;
+        }
+    }
+    if (first >= 0) {
+        ssd1306_fb_extend_dirty(fb, page, first, last);
+    }
+}
+
+// Bits of a page covered by rows y0..y1 (already clipped to the panel)
+static inline uint8_t ssd1306_fb_page_mask(int page, int y0, int y1)
+{
+    int top = y0 > page * 8 ? y0 - page * 8 : 0;
+    int bottom = y1 < page * 8 + 7 ? y1 - page * 8 : 7;
+    return (uint8_t)((0xFF << top) & (0xFF >> (7 - bottom)));
+}
+
+void ssd1306_fb_fill_rect(ssd1306_fb_t *fb, int x, int y, int w, int h, int color)
+{
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + w - 1 >= SSD1306_WIDTH ? SSD1306_WIDTH - 1 : x + w - 1;
+    int y1 = y + h - 1 >= SSD1306_HEIGHT ? SSD1306_HEIGHT - 1 : y + h - 1;
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    // Whole bytes per page: interior pages get 0xFF, edge pages a partial mask
+    for (int page = y0 / 8; page <= y1 / 8; page++) {
+        ssd1306_fb_apply_mask(fb, page, x0, x1, ssd1306_fb_page_mask(page, y0, y1), color);
+    }
+}
+
+void ssd1306_fb_hline(ssd1306_fb_t *fb, int x0, int x1, int y, int color)
+{
+    if (x0 > x1) {
+        int t = x0;
+        x0 = x1;
+        x1 = t;
+    }
+    ssd1306_fb_fill_rect(fb, x0, y, x1 - x0 + 1, 1, color);
+}
+
+void ssd1306_fb_vline(ssd1306_fb_t *fb, int x, int y0, int y1, int color)
+{
+    if (y0 > y1) {
+        int t = y0;
+        y0 = y1;
+        y1 = t;
+    }
+    ssd1306_fb_fill_rect(fb, x, y0, 1, y1 - y0 + 1, color);
+}
+
+void ssd1306_fb_rect(ssd1306_fb_t *fb, int x, int y, int w, int h, int color)
+{
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    ssd1306_fb_hline(fb, x, x + w - 1, y, color);
+    ssd1306_fb_hline(fb, x, x + w - 1, y + h - 1, color);
+    ssd1306_fb_vline(fb, x, y, y + h - 1, color);
+    ssd1306_fb_vline(fb, x + w - 1, y, y + h - 1, color);
+}
+
+void ssd1306_fb_line(ssd1306_fb_t *fb, int x0, int y0, int x1, int y1, int color)
+{
+    int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    int dy = y1 > y0 ? y1 - y0 : y0 - y1;
+    int sx = x0 < x1 ? 1 : -1;
+    int sy = y0 < y1 ? 1 : -1;
+    int err = dx - dy;
+
+    // Bresenham, emitting each straight run as one horizontal or vertical
+    // span so the byte-wise fills do the work instead of single pixels
+    int run_x = x0;
+    int run_y = y0;
+    while (1) {
+        bool last = x0 == x1 && y0 == y1;
+        int e2 = 2 * err;
+        int next_x = x0;
+        int next_y = y0;
+        if (!last) {
+            if (e2 > -dy) {
+                err -= dy;
+                next_x += sx;
+            }
+            if (e2 < dx) {
+                err += dx;
+                next_y += sy;
+            }
+        }
+
+        // The run ends when the step leaves the current row (x-major) or column (y-major)
+        bool run_ends = last || (dx >= dy ? next_y != y0 : next_x != x0);
+        if (run_ends) {
+            if (dx >= dy) {
+                ssd1306_fb_hline(fb, run_x, x0, y0, color);
+            } else {
+                ssd1306_fb_vline(fb, x0, run_y, y0, color);
+            }
+            run_x = next_x;
+            run_y = next_y;
+        }
+        if (last) {
+            break;
+        }
+        x0 = next_x;
+        y0 = next_y;
+    }
+}
+
+void ssd1306_fb_scroll_left(ssd1306_fb_t *fb, int x, int y, int w, int h, int columns)
+{
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + w - 1 >= SSD1306_WIDTH ? SSD1306_WIDTH - 1 : x + w - 1;
+    int y1 = y + h - 1 >= SSD1306_HEIGHT ? SSD1306_HEIGHT - 1 : y + h - 1;
+    if (x0 > x1 || y0 > y1 || columns <= 0) {
+        return;
+    }
+    if (columns > x1 - x0 + 1) {
+        columns = x1 - x0 + 1;
+    }
+
+    // Column-major pages: shifting left is a move along each page row
+    for (int page = y0 / 8; page <= y1 / 8; page++) {
+        uint8_t *row = &fb->buffer[page * SSD1306_WIDTH];
+        uint8_t mask = ssd1306_fb_page_mask(page, y0, y1);
+        bool changed = false;
+        for (int c = x0; c + columns <= x1; c++) {
+            uint8_t value = (row[c] & ~mask) | (row[c + columns] & mask);
+            changed |= value != row[c];
+            row[c] = value;
+        }
+        if (changed) {
+            ssd1306_fb_extend_dirty(fb, page, x0, x1 - columns);
+        }
+    }
+    // Vacated columns on the right
+    ssd1306_fb_fill_rect(fb, x1 - columns + 1, y0, columns, y1 - y0 + 1, 0);
+
+    // Whole pages: record the shift so the flush can let the panel do it.
+    // Dropping a record is always safe, the shifted columns are dirty anyway.
+    ssd1306_fb_hscroll_t *pending = &fb->hscroll;
+    bool page_aligned = (y0 % 8) == 0 && (y1 % 8) == 7 && x1 > x0;
+    bool same_area = pending->columns == 0 ||
+                     (pending->page0 == y0 / 8 && pending->page1 == y1 / 8 &&
+                      pending->x0 == x0 && pending->x1 == x1);
+    if (page_aligned && same_area && pending->columns + columns <= SSD1306_HW_SCROLL_MAX_STEPS) {
+        pending->page0 = y0 / 8;
+        pending->page1 = y1 / 8;
+        pending->x0 = x0;
+        pending->x1 = x1;
+        pending->columns += columns;
+    } else {
+        pending->columns = 0;
+    }
+}
+
+void ssd1306_fb_scroll_up(ssd1306_fb_t *fb, int rows)
+{
+    if (rows <= 0) {
+        return;
+    }
+    if (rows >= SSD1306_HEIGHT) {
+        ssd1306_fb_fill_rect(fb, 0, 0, SSD1306_WIDTH, SSD1306_HEIGHT, 0);
+        return;
+    }
+
+    // The panel shows the same RAM from a later row; mirror that here and
+    // blank what wrapped around to the bottom
+    ssd1306_fb_rotate_up(fb->buffer, rows);
+    ssd1306_fb_spread_dirty(fb);
+    fb->hscroll.columns = 0;
+    fb->start_line = (fb->start_line + rows) & (SSD1306_HEIGHT - 1);
+    ssd1306_fb_fill_rect(fb, 0, SSD1306_HEIGHT - rows, SSD1306_WIDTH, rows, 0);
+}
+
+// OR columns c0..c1-1 of one bitmap page into a framebuffer page, shifted by
+// shl (towards the bottom) or shr (the part spilling into the next page)
+static void ssd1306_fb_or_columns(ssd1306_fb_t *fb, int page, int x, const uint8_t *src,
+                                  int c0, int c1, int shl, int shr)
+{
+    uint8_t *dst = &fb->buffer[page * SSD1306_WIDTH + x];
+    int first = -1;
+    int last = -1;
+
+    for (int c = c0; c < c1; c++) {
+        uint8_t value = dst[c] | (uint8_t)(((unsigned)src[c] << shl) >> shr);
+        if (value != dst[c]) {
+            dst[c] = value;
+            if (first < 0) {
+                first = c;
+            }
+            last = c;
+        }
+    }
+    if (first >= 0) {
+        ssd1306_fb_extend_dirty(fb, page, x + first, x + last);
+    }
+}
+
+void ssd1306_fb_blit(ssd1306_fb_t *fb, int x, int y, const uint8_t *bitmap, int width, int pages)
+{
+    // Horizontal clip in columns of the bitmap
+    int c0 = x < 0 ? -x : 0;
+    int c1 = x + width > SSD1306_WIDTH ? SSD1306_WIDTH - x : width;
+    if (c0 >= c1) {
+        return;
+    }
+
+    int shift = y & 7;              // Floor modulo, also for negative y
+    int page0 = (y - shift) / 8;
+
+    for (int p = 0; p < pages; p++) {
+        const uint8_t *src = &bitmap[p * width];
+        int page = page0 + p;
+        // Page-aligned rows are one byte store per column; otherwise each
+        // column is split between this page and the next
+        if (page >= 0 && page < SSD1306_PAGES) {
+            ssd1306_fb_or_columns(fb, page, x, src, c0, c1, shift, 0);
+        }
+        if (shift != 0 && page + 1 >= 0 && page + 1 < SSD1306_PAGES) {
+            ssd1306_fb_or_columns(fb, page + 1, x, src, c0, c1, 0, 8 - shift);
+        }
+    }
+}
+
+int ssd1306_fb_draw_char(ssd1306_fb_t *fb, int x, int y, char c, const ssd1306_font_t *font)
+{
+    const ssd1306_glyph_t *glyph = ssd1306_font_glyph(font, c);
+    if (glyph == NULL) {
+        return 0;
+    }
+    if (glyph->width > 0) {
+        ssd1306_fb_blit(fb, x + glyph->xoff, y, &font->bitmap[glyph->offset], glyph->width, font->pages);
+    }
+    return glyph->advance;
+}
+
+int ssd1306_fb_draw_text(ssd1306_fb_t *fb, int x, int y, const char *text, const ssd1306_font_t *font)
+{
+    for (; *text; text++) {
+        x += ssd1306_fb_draw_char(fb, x, y, *text, font);
+    }
+    return x;
+}
+
+void ssd1306_fb_write_text(ssd1306_fb_t *fb, int x, int y, const char *text)
+{
+    int text_x = x;
+    int text_y = y;
+    
+    for (int i = 0; text[i] != '\0'; i++) {
+        char c = text[i];
+        
+        // Handle newline
+        if (c == '\n') {
+            text_x = x;
+            text_y += 8;
+            continue;
+        }
+        
+        // Check bounds
+        if (text_x + 8 > SSD1306_WIDTH) {
+            text_x = x;
+            text_y += 8;
+        }
+        if (text_y + 8 > SSD1306_HEIGHT) {
+            break;
+        }
+        
+        ssd1306_fb_draw_char(fb, text_x, text_y, c, &ssd1306_font_8x8);
+        text_x += 8;
+    }
+}
+
+void ssd1306_fb_invalidate(ssd1306_fb_t *fb, int x, int y, int w, int h)
+{
+    int x0 = x < 0 ? 0 : x;
+    int y0 = y < 0 ? 0 : y;
+    int x1 = x + w - 1 >= SSD1306_WIDTH ? SSD1306_WIDTH - 1 : x + w - 1;
+    int y1 = y + h - 1 >= SSD1306_HEIGHT ? SSD1306_HEIGHT - 1 : y + h - 1;
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    // Recorded rather than applied to the shadow: the range has to travel
+    // with the frame to whichever buffer gets flushed
+    for (int page = y0 / 8; page <= y1 / 8; page++) {
+        ssd1306_fb_extend_dirty(fb, page, x0, x1);
+        if (x0 < fb->stale_min[page]) {
+            fb->stale_min[page] = x0;
+        }
+        if (x1 > fb->stale_max[page]) {
+            fb->stale_max[page] = x1;
+        }
+    }
+}
+
+void ssd1306_fb_copy_frame(ssd1306_fb_t *dst, ssd1306_fb_t *src)
+{
+    // An unflushed frame in dst was drawn before the source scrolled up:
+    // its dirty columns and pending shift no longer line up
+    if (dst->start_line != src->start_line) {
+        ssd1306_fb_spread_dirty(dst);
+        dst->hscroll.columns = 0;
+        dst->start_line = src->start_line;
+    }
+
+    // Pending shifts of the same area add up; otherwise keep the newer one.
+    // The flush tracks what the panel really did, so a shift only has to
+    // be worthwhile, never exact.
+    ssd1306_fb_hscroll_t *pending = &dst->hscroll;
+    const ssd1306_fb_hscroll_t *incoming = &src->hscroll;
+    if (incoming->columns > 0) {
+        bool same_area = pending->columns > 0 &&
+                         pending->page0 == incoming->page0 && pending->page1 == incoming->page1 &&
+                         pending->x0 == incoming->x0 && pending->x1 == incoming->x1;
+        int columns = same_area ? pending->columns + incoming->columns : incoming->columns;
+        *pending = *incoming;
+        pending->columns = columns <= SSD1306_HW_SCROLL_MAX_STEPS ? columns : 0;
+    }
+    src->hscroll.columns = 0;
+
+    memcpy(dst->buffer, src->buffer, sizeof(dst->buffer));
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        if (src->dirty_min[page] <= src->dirty_max[page]) {
+            ssd1306_fb_extend_dirty(dst, page, src->dirty_min[page], src->dirty_max[page]);
+        }
+        if (src->stale_min[page] < dst->stale_min[page]) {
+            dst->stale_min[page] = src->stale_min[page];
+        }
+        if (src->stale_max[page] > dst->stale_max[page]) {
+            dst->stale_max[page] = src->stale_max[page];
+        }
+    }
+    ssd1306_fb_mark_clean(src);
+}
+
+// Byte of RAM page `page` at column x when the image is shown from RAM row `start`
+static inline uint8_t ssd1306_fb_ram_byte(const uint8_t *image, int page, int x, int start)
+{
+    int row = (page * 8 - start) & (SSD1306_HEIGHT - 1);
+    int shift = row & 7;
+    uint8_t byte = image[(row >> 3) * SSD1306_WIDTH + x] >> shift;
+    if (shift) {
+        int next = ((row >> 3) + 1) & (SSD1306_PAGES - 1);
+        byte |= image[next * SSD1306_WIDTH + x] << (8 - shift);
+    }
+    return byte;
+}
+
+// Move the panel's start line to fb->start_line
+static int ssd1306_fb_flush_start_line(ssd1306_fb_t *fb, const ssd1306_bus_t *bus)
+{
+    if (fb->panel_start_line == fb->start_line) {
+        return 0;
+    }
+    int err = ssd1306_cmd_set_start_line(bus, fb->start_line);
+    if (err != 0) {
+        return err;
+    }
+    ssd1306_fb_rotate_up(fb->shadow, fb->start_line - fb->panel_start_line);
+    fb->panel_start_line = fb->start_line;
+    return 0;
+}
+
+// Let the panel perform the recorded left shift, one column per step
+static int ssd1306_fb_flush_hscroll(ssd1306_fb_t *fb, const ssd1306_bus_t *bus)
+{
+    ssd1306_fb_hscroll_t scroll = fb->hscroll;
+    fb->hscroll.columns = 0;
+
+    // Only when the area maps to whole RAM pages without wrapping
+    int page_offset = fb->start_line / 8;
+    bool mappable = (fb->start_line % 8) == 0 && scroll.page1 + page_offset < SSD1306_PAGES;
+    // Without content scroll the shifted columns are already dirty
+    if (!fb->content_scroll || scroll.columns == 0 || !fb->shadow_valid || !mappable) {
+        return 0;
+    }
+
+    // Waiting after every step also spaces out steps of consecutive flushes
+    for (int step = 0; step < scroll.columns; step++) {
+        int err = ssd1306_cmd_scroll_left(bus, scroll.page0 + page_offset, scroll.page1 + page_offset,
+                                          scroll.x0, scroll.x1);
+        if (err != 0) {
+            ssd1306_fb_invalidate_shadow(fb);
+            return err;
+        }
+        ssd1306_fb_rotate_left(fb->shadow, scroll.page0, scroll.page1, scroll.x0, scroll.x1);
+        if (bus->delay_ms) {
+            bus->delay_ms(bus->ctx, SSD1306_CONTENT_SCROLL_DELAY_MS);
+        }
+    }
+
+    // The panel changed where the buffer may not have (wrapped columns);
+    // the shadow comparison trims this back to what really differs
+    for (int page = scroll.page0; page <= scroll.page1; page++) {
+        ssd1306_fb_extend_dirty(fb, page, scroll.x0, scroll.x1);
+    }
+    return 0;
+}
+
+// True if the panel already shows this byte of RAM page `page`
+static inline bool ssd1306_fb_column_sent(const ssd1306_fb_t *fb, int page, int x, int start)
+{
+    return fb->shadow_valid &&
+           ssd1306_fb_ram_byte(fb->buffer, page, x, start) == ssd1306_fb_ram_byte(fb->shadow, page, x, start);
+}
+
+// Window plus data for columns x0..x1 of one RAM page
+static int ssd1306_fb_flush_span(ssd1306_fb_t *fb, const ssd1306_bus_t *bus, int page, int x0, int x1, int start)
+{
+    uint8_t data[SSD1306_WIDTH];
+    const uint8_t *bytes = &fb->buffer[page * SSD1306_WIDTH + x0];
+    if (start != 0) {
+        for (int x = x0; x <= x1; x++) {
+            data[x - x0] = ssd1306_fb_ram_byte(fb->buffer, page, x, start);
+        }
+        bytes = data;
+    }
+
+    int err = ssd1306_cmd_set_window(bus, x0, x1, page, page);
+    if (err == 0) {
+        err = bus->write(bus->ctx, SSD1306_CONTROL_DATA_STREAM, bytes, x1 - x0 + 1);
+    }
+    return err;
+}
+
+int ssd1306_fb_flush(ssd1306_fb_t *fb, const ssd1306_bus_t *bus)
+{
+    int err = ssd1306_fb_flush_start_line(fb, bus);
+    if (err == 0) {
+        err = ssd1306_fb_flush_hscroll(fb, bus);
+    }
+    if (err != 0) {
+        return err;
+    }
+
+    // Invalidated columns: a shadow that differs everywhere forces the resend
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        for (int x = fb->stale_min[page]; x <= fb->stale_max[page]; x++) {
+            fb->shadow[page * SSD1306_WIDTH + x] = ~fb->buffer[page * SSD1306_WIDTH + x];
+        }
+    }
+
+    int start = fb->start_line;
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        // A RAM page holds rows of one picture page, or of two when the
+        // start line is not page aligned
+        int row = (page * 8 - start) & (SSD1306_HEIGHT - 1);
+        int first = row >> 3;
+        int second = ((row + 7) & (SSD1306_HEIGHT - 1)) >> 3;
+        int x0 = fb->dirty_min[first] < fb->dirty_min[second] ? fb->dirty_min[first] : fb->dirty_min[second];
+        int x1 = fb->dirty_max[first] > fb->dirty_max[second] ? fb->dirty_max[first] : fb->dirty_max[second];
+        if (x0 > x1) {
+            continue;
+        }
+
+        // Send only the columns the panel does not show yet, splitting
+        // where a run of matching columns costs more than a new window
+        int x = x0;
+        while (x <= x1) {
+            while (x <= x1 && ssd1306_fb_column_sent(fb, page, x, start)) {
+                x++;
+            }
+            if (x > x1) {
+                break;
+            }
+            int end = x;
+            for (int i = x + 1; i <= x1 && i - end <= SSD1306_FLUSH_SPLIT_GAP; i++) {
+                if (!ssd1306_fb_column_sent(fb, page, i, start)) {
+                    end = i;
+                }
+            }
+            err = ssd1306_fb_flush_span(fb, bus, page, x, end, start);
+            if (err != 0) {
+                return err;
+            }
+            x = end + 1;
+        }
+    }
+
+    memcpy(fb->shadow, fb->buffer, sizeof(fb->shadow));
+    fb->shadow_valid = true;
+    ssd1306_fb_mark_clean(fb);
+    return 0;
+}
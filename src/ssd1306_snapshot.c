@@ -0,0 +1,134 @@
+#include "ssd1306_snapshot.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define RLE_MAX_LITERAL     128
+#define RLE_MIN_REPEAT      3
+#define RLE_MAX_REPEAT      (0x7F + RLE_MIN_REPEAT)
+
+// Length of the run of equal bytes starting at `data`
+static size_t rle_repeat_length(const uint8_t *data, size_t len)
+{
+    size_t n = 1;
+    while (n < len && n < RLE_MAX_REPEAT && data[n] == data[0]) {
+        n++;
+    }
+    return n;
+}
+
+size_t ssd1306_snapshot_encode(const uint8_t *buffer, uint16_t seq, uint8_t *out, size_t size)
+{
+    if (size < SSD1306_SNAPSHOT_HEADER_SIZE) {
+        return 0;
+    }
+    out[0] = SSD1306_SNAPSHOT_MAGIC0;
+    out[1] = SSD1306_SNAPSHOT_MAGIC1;
+    out[2] = SSD1306_SNAPSHOT_VERSION;
+    out[3] = seq & 0xFF;
+    out[4] = seq >> 8;
+    out[5] = SSD1306_WIDTH;
+    out[6] = SSD1306_HEIGHT;
+
+    size_t pos = SSD1306_SNAPSHOT_HEADER_SIZE;
+    size_t i = 0;
+    while (i < SSD1306_SNAPSHOT_FRAME_SIZE) {
+        size_t remaining = SSD1306_SNAPSHOT_FRAME_SIZE - i;
+        size_t repeat = rle_repeat_length(&buffer[i], remaining);
+        if (repeat >= RLE_MIN_REPEAT) {
+            if (pos + 2 > size) {
+                return 0;
+            }
+            out[pos++] = 0x80 | (repeat - RLE_MIN_REPEAT);
+            out[pos++] = buffer[i];
+            i += repeat;
+            continue;
+        }
+
+        // Literals up to the next run worth coding as a repeat
+        size_t literal = 0;
+        while (literal < remaining && literal < RLE_MAX_LITERAL &&
+               rle_repeat_length(&buffer[i + literal], remaining - literal) < RLE_MIN_REPEAT) {
+            literal++;
+        }
+        if (pos + 1 + literal > size) {
+            return 0;
+        }
+        out[pos++] = literal - 1;
+        memcpy(&out[pos], &buffer[i], literal);
+        pos += literal;
+        i += literal;
+    }
+    return pos;
+}
+
+int ssd1306_snapshot_decode(const uint8_t *pkt, size_t len, uint8_t *buffer, uint16_t *seq)
+{
+    if (len < SSD1306_SNAPSHOT_HEADER_SIZE ||
+        pkt[0] != SSD1306_SNAPSHOT_MAGIC0 || pkt[1] != SSD1306_SNAPSHOT_MAGIC1 ||
+        pkt[2] != SSD1306_SNAPSHOT_VERSION ||
+        pkt[5] != SSD1306_WIDTH || pkt[6] != SSD1306_HEIGHT) {
+        return -1;
+    }
+    if (seq) {
+        *seq = pkt[3] | (pkt[4] << 8);
+    }
+
+    size_t pos = SSD1306_SNAPSHOT_HEADER_SIZE;
+    size_t i = 0;
+    while (pos < len) {
+        uint8_t control = pkt[pos++];
+        if (control & 0x80) {
+            size_t repeat = (control & 0x7F) + RLE_MIN_REPEAT;
+            if (pos >= len || i + repeat > SSD1306_SNAPSHOT_FRAME_SIZE) {
+                return -1;
+            }
+            memset(&buffer[i], pkt[pos++], repeat);
+            i += repeat;
+        } else {
+            size_t literal = control + 1;
+            if (pos + literal > len || i + literal > SSD1306_SNAPSHOT_FRAME_SIZE) {
+                return -1;
+            }
+            memcpy(&buffer[i], &pkt[pos], literal);
+            pos += literal;
+            i += literal;
+        }
+    }
+    return i == SSD1306_SNAPSHOT_FRAME_SIZE ? 0 : -1;
+}
+
+size_t ssd1306_snapshot_to_pbm(const uint8_t *buffer, uint8_t *out, size_t size)
+{
+    const size_t row_bytes = SSD1306_WIDTH / 8;
+    int header = snprintf((char *)out, size, "P4\n%d %d\n", SSD1306_WIDTH, SSD1306_HEIGHT);
+    if (header < 0 || (size_t)header + row_bytes * SSD1306_HEIGHT > size) {
+        return 0;
+    }
+
+    // PBM rows are MSB-first with 1 = black; the panel lights a set bit
+    uint8_t *pixels = &out[header];
+    for (int y = 0; y < SSD1306_HEIGHT; y++) {
+        const uint8_t *page = &buffer[(y / 8) * SSD1306_WIDTH];
+        uint8_t mask = 1 << (y % 8);
+        for (size_t b = 0; b < row_bytes; b++) {
+            uint8_t bits = 0;
+            for (int i = 0; i < 8; i++) {
+                if (!(page[b * 8 + i] & mask)) {
+                    bits |= 0x80 >> i;
+                }
+            }
+            pixels[y * row_bytes + b] = bits;
+        }
+    }
+    return header + row_bytes * SSD1306_HEIGHT;
+}
+
+uint32_t ssd1306_snapshot_hash(const uint8_t *buffer)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < SSD1306_SNAPSHOT_FRAME_SIZE; i++) {
+        hash = (hash ^ buffer[i]) * 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,154 @@
+#include "ssd1306_sparkline.h"
+
+#include <string.h>
+
+// Headroom added on each side when autoscale grows the range, as a
+// fraction of the span, so a slowly drifting signal does not rescale
+// on every sample
+#define SPARKLINE_AUTOSCALE_MARGIN  0.125f
+
+void ssd1306_sparkline_init(ssd1306_sparkline_t *chart, int x, int y, int w, int h, float min, float max)
+{
+    memset(chart, 0, sizeof(*chart));
+
+    if (x < 0) {
+        w += x;
+        x = 0;
+    }
+    if (y < 0) {
+        h += y;
+        y = 0;
+    }
+    if (x + w > SSD1306_WIDTH) {
+        w = SSD1306_WIDTH - x;
+    }
+    if (y + h > SSD1306_HEIGHT) {
+        h = SSD1306_HEIGHT - y;
+    }
+    if (w > SSD1306_SPARKLINE_MAX_SAMPLES) {
+        w = SSD1306_SPARKLINE_MAX_SAMPLES;
+    }
+
+    chart->x = x;
+    chart->y = y;
+    chart->w = w > 0 ? w : 0;
+    chart->h = h > 0 ? h : 0;
+    chart->min = min < max ? min : max;
+    chart->max = min < max ? max : min;
+    chart->autoscale = min == max;
+    chart->redraw = true;
+}
+
+void ssd1306_sparkline_reset(ssd1306_sparkline_t *chart)
+{
+    chart->head = 0;
+    chart->count = 0;
+    chart->pending = 0;
+    chart->redraw = true;
+    if (chart->autoscale) {
+        chart->min = chart->max = 0.0f;
+    }
+}
+
+// i-th sample, 0 = oldest
+static inline float sparkline_sample(const ssd1306_sparkline_t *chart, int i)
+{
+    int index = chart->head - chart->count + i;
+    if (index < 0) {
+        index += chart->w;
+    }
+    return chart->samples[index];
+}
+
+static void sparkline_grow_range(ssd1306_sparkline_t *chart, float value)
+{
+    if (chart->count == 0) {
+        chart->min = chart->max = value;
+        chart->redraw = true;
+        return;
+    }
+    if (value >= chart->min && value <= chart->max) {
+        return;
+    }
+
+    float min = value < chart->min ? value : chart->min;
+    float max = value > chart->max ? value : chart->max;
+    float margin = (max - min) * SPARKLINE_AUTOSCALE_MARGIN;
+    chart->min = value < chart->min ? min - margin : min;
+    chart->max = value > chart->max ? max + margin : max;
+    chart->redraw = true;
+}
+
+void ssd1306_sparkline_push(ssd1306_sparkline_t *chart, float value)
+{
+    if (chart->w == 0) {
+        return;
+    }
+    if (chart->autoscale) {
+        sparkline_grow_range(chart, value);
+    }
+
+    chart->samples[chart->head] = value;
+    chart->head = (chart->head + 1) % chart->w;
+    if (chart->count < chart->w) {
+        chart->count++;
+    }
+    if (chart->pending < chart->w) {
+        chart->pending++;
+    }
+}
+
+// Panel row of a value; out-of-range values stick to the top or bottom edge
+static int sparkline_row(const ssd1306_sparkline_t *chart, float value)
+{
+    int bottom = chart->y + chart->h - 1;
+    float span = chart->max - chart->min;
+    if (span <= 0.0f) {
+        return chart->y + (chart->h - 1) / 2;
+    }
+
+    float scaled = (value - chart->min) / span * (float)(chart->h - 1);
+    int offset = (int)(scaled + 0.5f);
+    if (scaled < 0.0f) {
+        offset = 0;
+    } else if (offset > chart->h - 1) {
+        offset = chart->h - 1;
+    }
+    return bottom - offset;
+}
+
+// Draw samples first..count-1 into their columns, joined to the sample before
+static void sparkline_draw_columns(const ssd1306_sparkline_t *chart, ssd1306_fb_t *fb, int first)
+{
+    int column = chart->x + chart->w - chart->count + first;
+    int prev = first > 0 ? sparkline_row(chart, sparkline_sample(chart, first - 1)) : -1;
+
+    for (int i = first; i < chart->count; i++, column++) {
+        int row = sparkline_row(chart, sparkline_sample(chart, i));
+        ssd1306_fb_vline(fb, column, prev < 0 ? row : prev, row, 1);
+        prev = row;
+    }
+}
+
+void ssd1306_sparkline_draw(ssd1306_sparkline_t *chart, ssd1306_fb_t *fb)
+{
+    if (chart->w == 0 || chart->h == 0) {
+        return;
+    }
+
+    if (chart->redraw || chart->pending >= chart->w) {
+        ssd1306_fb_fill_rect(fb, chart->x, chart->y, chart->w, chart->h, 0);
+        sparkline_draw_columns(chart, fb, 0);
+        chart->redraw = false;
+    } else if (chart->pending > 0) {
+        ssd1306_fb_scroll_left(fb, chart->x, chart->y, chart->w, chart->h, chart->pending);
+        sparkline_draw_columns(chart, fb, chart->count - chart->pending);
+        if (chart->count == chart->w) {
+            // The oldest sample lost its predecessor: keep just its point
+            int row = sparkline_row(chart, sparkline_sample(chart, 0));
+            ssd1306_fb_fill_rect(fb, chart->x, chart->y, 1, chart->h, 0);
+            ssd1306_fb_set_pixel(fb, chart->x, row, 1);
+        }
+    }
+    chart->pending = 0;
+}
@@ -0,0 +1,84 @@
+#include "sys_profiler.h"
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "profiler_stats.h"
+#include "sched_task.h"
+#include "teleplot_udp.h"
+
+static const char *PROF_TAG = "profiler";
+
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY
+static profiler_t s_prof;
+
+// Czas CPU i zapas stosu każdego wątku
+static void sys_profiler_tasks(void) {
+    static TaskStatus_t status[PROFILER_MAX_TASKS];
+    uint32_t total = 0;
+    UBaseType_t count = uxTaskGetSystemState(status, PROFILER_MAX_TASKS, &total);
+    if (count == 0) {
+        ESP_LOGW(PROF_TAG, "Więcej niż %d wątków - zwiększ PROFILER_MAX_TASKS", PROFILER_MAX_TASKS);
+        return;
+    }
+
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    uint32_t total_delta = profiler_begin(&s_prof, total);
+    const char *top_name = NULL;
+    float top_cpu = 0.0f;
+#endif
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        profiler_task_t *task = profiler_task(&s_prof, status[i].pcTaskName);
+        if (task == NULL) {
+            continue;
+        }
+        teleplot_publish(task->stack_channel, (float)status[i].usStackHighWaterMark);
+
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        float cpu = profiler_cpu_percent(task, status[i].ulRunTimeCounter, total_delta, portNUM_PROCESSORS);
+        if (cpu < 0.0f) {
+            continue;
+        }
+        teleplot_publish(task->cpu_channel, cpu);
+        if (strncmp(task->task, "IDLE", 4) != 0 && cpu > top_cpu) {
+            top_cpu = cpu;
+            top_name = task->task;
+        }
+        ESP_LOGD(PROF_TAG, "%-15s cpu %5.1f%%  stos wolny %5u B", task->task, cpu,
+                 (unsigned)status[i].usStackHighWaterMark);
+#endif
+    }
+
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    if (top_name) {
+        ESP_LOGI(PROF_TAG, "Najwięcej CPU: %s %.1f%%", top_name, top_cpu);
+    }
+#endif
+}
+#endif
+
+// Zadanie planisty: jeden pomiar wszystkich wątków i sterty
+static void sys_profiler_job(void *arg) {
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY
+    sys_profiler_tasks();
+#endif
+
+    size_t free_heap = heap_caps_get_free_size(MALLOC_CAP_DEFAULT);
+    size_t min_heap = heap_caps_get_minimum_free_size(MALLOC_CAP_DEFAULT);
+    size_t largest = heap_caps_get_largest_free_block(MALLOC_CAP_DEFAULT);
+    teleplot_publish("sys.heap.free", (float)free_heap);
+    teleplot_publish("sys.heap.min", (float)min_heap);
+    teleplot_publish("sys.heap.largest", (float)largest);
+    ESP_LOGI(PROF_TAG, "Sterta: wolne %u B, minimum %u B, największy blok %u B",
+             (unsigned)free_heap, (unsigned)min_heap, (unsigned)largest);
+}
+
+void sys_profiler_start(void) {
+#if !CONFIG_FREERTOS_USE_TRACE_FACILITY
+    ESP_LOGW(PROF_TAG, "Brak CONFIG_FREERTOS_USE_TRACE_FACILITY - tylko statystyki sterty");
+#endif
+    sched_add("profiler", SYS_PROFILER_PERIOD_MS, SYS_PROFILER_PERIOD_MS / 10, sys_profiler_job, NULL);
+}
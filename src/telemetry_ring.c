@@ -0,0 +1,68 @@
+#include "telemetry_ring.h"
+
+// Bufor Vyukova: każdy slot ma numer sekwencyjny mówiący, czy jest wolny dla
+// pozycji `pos` (seq == pos) czy zapełniony (seq == pos + 1). Numer jest
+// przechowywany pomniejszony o indeks slotu, dzięki czemu zera = pusty bufor.
+
+#define RING_MASK (TELEMETRY_RING_SIZE - 1)
+
+_Static_assert((TELEMETRY_RING_SIZE & RING_MASK) == 0,
+               "TELEMETRY_RING_SIZE musi być potęgą dwójki");
+
+static inline unsigned slot_sequence(telemetry_slot_t *slot, unsigned index) {
+    return atomic_load_explicit(&slot->sequence, memory_order_acquire) + index;
+}
+
+static inline void slot_publish(telemetry_slot_t *slot, unsigned index, unsigned seq) {
+    atomic_store_explicit(&slot->sequence, seq - index, memory_order_release);
+}
+
+bool telemetry_ring_push(telemetry_ring_t *ring, const telemetry_sample_t *sample) {
+    unsigned pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    telemetry_slot_t *slot;
+
+    for (;;) {
+        unsigned index = pos & RING_MASK;
+        slot = &ring->slots[index];
+        int diff = (int)(slot_sequence(slot, index) - pos);
+
+        if (diff == 0) {
+            // Slot wolny - rezerwujemy pozycję
+            if (atomic_compare_exchange_weak_explicit(&ring->head, &pos, pos + 1,
+                                                      memory_order_relaxed,
+                                                      memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Konsument nie zwolnił jeszcze slotu - bufor pełny
+            atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+            return false;
+        } else {
+            // Inny producent zajął pozycję - spróbuj z aktualną głową
+            pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        }
+    }
+
+    slot->sample = *sample;
+    slot_publish(slot, pos & RING_MASK, pos + 1);
+    return true;
+}
+
+bool telemetry_ring_pop(telemetry_ring_t *ring, telemetry_sample_t *out) {
+    unsigned pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    unsigned index = pos & RING_MASK;
+    telemetry_slot_t *slot = &ring->slots[index];
+
+    if ((int)(slot_sequence(slot, index) - (pos + 1)) < 0) {
+        return false;
+    }
+
+    *out = slot->sample;
+    slot_publish(slot, index, pos + TELEMETRY_RING_SIZE);
+    atomic_store_explicit(&ring->tail, pos + 1, memory_order_relaxed);
+    return true;
+}
+
+uint32_t telemetry_ring_dropped(const telemetry_ring_t *ring) {
+    return atomic_load_explicit(&((telemetry_ring_t *)ring)->dropped, memory_order_relaxed);
+}
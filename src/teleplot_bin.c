@@ -0,0 +1,281 @@
+#include "teleplot_bin.h"
+#include "teleplot_format.h"
+#include <string.h>
+
+// Precyzja tekstu dla kanałów F32 zarejestrowanych automatycznie
+#define DEFAULT_F32_DECIMALS 3
+
+static const float s_pow10f[] = { 1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f };
+#define MAX_I16_DECIMALS (sizeof(s_pow10f) / sizeof(s_pow10f[0]) - 1)
+
+static void put_u16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_u32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static uint16_t get_u16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static size_t value_size(uint8_t type) {
+    return type == TELEPLOT_BIN_I16 ? 2 : 4;
+}
+
+static void write_header(teleplot_bin_dict_t *dict, uint8_t *buf, uint8_t type) {
+    buf[0] = TELEPLOT_BIN_MAGIC0;
+    buf[1] = TELEPLOT_BIN_MAGIC1;
+    buf[2] = TELEPLOT_BIN_VERSION;
+    buf[3] = type;
+    put_u16(&buf[4], dict->seq++);
+}
+
+int teleplot_bin_register(teleplot_bin_dict_t *dict, const char *name,
+                          uint8_t type, uint8_t decimals) {
+    size_t name_len = strlen(name);
+    if (name_len > TELEPLOT_BIN_MAX_NAME || dict->count >= TELEPLOT_BIN_MAX_CHANNELS) {
+        return -1;
+    }
+    if (type == TELEPLOT_BIN_I16 && decimals > MAX_I16_DECIMALS) {
+        return -1;
+    }
+
+    teleplot_bin_channel_t *ch = &dict->channels[dict->count];
+    memcpy(ch->name, name, name_len + 1);
+    ch->type = type;
+    ch->decimals = decimals;
+    return dict->count++;
+}
+
+int teleplot_bin_channel_id(teleplot_bin_dict_t *dict, const char *name, bool *added) {
+    if (added) {
+        *added = false;
+    }
+    for (int i = 0; i < dict->count; i++) {
+        if (strcmp(dict->channels[i].name, name) == 0) {
+            return i;
+        }
+    }
+
+    int id = teleplot_bin_register(dict, name, TELEPLOT_BIN_F32, DEFAULT_F32_DECIMALS);
+    if (id >= 0 && added) {
+        *added = true;
+    }
+    return id;
+}
+
+size_t teleplot_bin_write_dict(teleplot_bin_dict_t *dict, uint8_t *buf, size_t size,
+                               uint8_t *next) {
+    if (size < TELEPLOT_BIN_HEADER_SIZE + 1) {
+        return 0;
+    }
+
+    size_t len = TELEPLOT_BIN_HEADER_SIZE + 1;
+    uint8_t count = 0;
+    uint8_t id = *next;
+
+    for (; id < dict->count; id++) {
+        const teleplot_bin_channel_t *ch = &dict->channels[id];
+        size_t name_len = strlen(ch->name);
+        if (len + 4 + name_len > size) {
+            break;
+        }
+        buf[len++] = id;
+        buf[len++] = ch->type;
+        buf[len++] = ch->decimals;
+        buf[len++] = (uint8_t)name_len;
+        memcpy(&buf[len], ch->name, name_len);
+        len += name_len;
+        count++;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+    write_header(dict, buf, TELEPLOT_BIN_PKT_DICT);
+    buf[TELEPLOT_BIN_HEADER_SIZE] = count;
+    *next = id;
+    return len;
+}
+
+void teleplot_bin_frame_begin(teleplot_bin_dict_t *dict, teleplot_bin_frame_t *frame,
+                              uint8_t *buf, size_t size) {
+    write_header(dict, buf, TELEPLOT_BIN_PKT_DATA);
+    put_u32(&buf[TELEPLOT_BIN_HEADER_SIZE], 0);
+    buf[TELEPLOT_BIN_HEADER_SIZE + 4] = 0;
+
+    frame->buf = buf;
+    frame->size = size;
+    frame->len = TELEPLOT_BIN_HEADER_SIZE + 5;
+    frame->count = 0;
+    frame->base_us = 0;
+}
+
+bool teleplot_bin_frame_add(const teleplot_bin_dict_t *dict, teleplot_bin_frame_t *frame,
+                            uint8_t id, int64_t timestamp_us, float value) {
+    if (id >= dict->count || frame->count == UINT8_MAX || timestamp_us < 0) {
+        return false;
+    }
+
+    const teleplot_bin_channel_t *ch = &dict->channels[id];
+    if (frame->len + 3 + value_size(ch->type) > frame->size) {
+        return false;
+    }
+
+    // Pierwsza próbka ustala czas bazowy pakietu (z dokładnością do 1 ms)
+    if (frame->count == 0) {
+        frame->base_us = timestamp_us / 1000 * 1000;
+        put_u32(&frame->buf[TELEPLOT_BIN_HEADER_SIZE], (uint32_t)(timestamp_us / 1000));
+    }
+    int64_t dt = (timestamp_us - frame->base_us) / TELEPLOT_BIN_DT_UNIT_US;
+    if (dt < INT16_MIN || dt > INT16_MAX) {
+        return false;
+    }
+
+    uint8_t *p = &frame->buf[frame->len];
+    *p++ = id;
+    put_u16(p, (uint16_t)(int16_t)dt);
+    p += 2;
+    if (ch->type == TELEPLOT_BIN_I16) {
+        float scaled = value * s_pow10f[ch->decimals];
+        int32_t raw = (int32_t)(scaled + (scaled >= 0 ? 0.5f : -0.5f));
+        if (raw > INT16_MAX) {
+            raw = INT16_MAX;
+        } else if (raw < INT16_MIN) {
+            raw = INT16_MIN;
+        }
+        put_u16(p, (uint16_t)(int16_t)raw);
+    } else {
+        uint32_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        put_u32(p, bits);
+    }
+
+    frame->len += 3 + value_size(ch->type);
+    frame->count++;
+    frame->buf[TELEPLOT_BIN_HEADER_SIZE + 4] = frame->count;
+    return true;
+}
+
+static int decode_dict(teleplot_bin_dict_t *dict, const uint8_t *p, const uint8_t *end) {
+    if (p >= end) {
+        return -1;
+    }
+    uint8_t count = *p++;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (end - p < 4) {
+            return -1;
+        }
+        uint8_t id = p[0];
+        uint8_t type = p[1];
+        uint8_t decimals = p[2];
+        uint8_t name_len = p[3];
+        p += 4;
+        if (id >= TELEPLOT_BIN_MAX_CHANNELS || name_len > TELEPLOT_BIN_MAX_NAME ||
+            end - p < name_len || (type != TELEPLOT_BIN_F32 && type != TELEPLOT_BIN_I16) ||
+            (type == TELEPLOT_BIN_I16 && decimals > MAX_I16_DECIMALS) ||
+            decimals > TELEPLOT_FORMAT_MAX_DECIMALS) {
+            return -1;
+        }
+
+        teleplot_bin_channel_t *ch = &dict->channels[id];
+        memcpy(ch->name, p, name_len);
+        ch->name[name_len] = '\0';
+        ch->type = type;
+        ch->decimals = decimals;
+        dict->known[id] = true;
+        p += name_len;
+    }
+    return 0;
+}
+
+static int decode_data(teleplot_bin_dict_t *dict, const uint8_t *p, const uint8_t *end,
+                       char *out, size_t out_size) {
+    if (end - p < 5) {
+        return -1;
+    }
+    int64_t base_us = (int64_t)get_u32(p) * 1000;
+    p += 4;
+    uint8_t count = *p++;
+    size_t len = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (p >= end) {
+            return -1;
+        }
+        uint8_t id = *p++;
+        if (id >= TELEPLOT_BIN_MAX_CHANNELS || !dict->known[id]) {
+            // Bez słownika nie znamy rozmiaru wartości - reszta pakietu jest nieczytelna
+            dict->unknown_samples += count - i;
+            break;
+        }
+
+        const teleplot_bin_channel_t *ch = &dict->channels[id];
+        if ((size_t)(end - p) < 2 + value_size(ch->type)) {
+            return -1;
+        }
+        int64_t timestamp_us = base_us + (int16_t)get_u16(p) * TELEPLOT_BIN_DT_UNIT_US;
+        p += 2;
+
+        float value;
+        if (ch->type == TELEPLOT_BIN_I16) {
+            value = (int16_t)get_u16(p) / s_pow10f[ch->decimals];
+        } else {
+            uint32_t bits = get_u32(p);
+            memcpy(&value, &bits, sizeof(value));
+        }
+        p += value_size(ch->type);
+
+        // Linia ma ograniczoną długość, więc błąd formatowania oznacza wartość,
+        // której nie da się zapisać - pomijamy tylko tę próbkę
+        char line[TELEPLOT_BIN_MAX_LINE];
+        int n = teleplot_format_metric_at(line, sizeof(line), ch->name, timestamp_us,
+                                          value, ch->decimals);
+        if (n < 0) {
+            dict->skipped_samples++;
+            continue;
+        }
+
+        size_t sep = len > 0 ? 1 : 0;
+        if (len + sep + (size_t)n > out_size) {
+            return -1;
+        }
+        if (sep) {
+            out[len] = '\n';
+        }
+        memcpy(out + len + sep, line, (size_t)n);
+        len += sep + n;
+    }
+    return (int)len;
+}
+
+int teleplot_bin_decode(teleplot_bin_dict_t *dict, const uint8_t *pkt, size_t len,
+                        char *out, size_t out_size) {
+    if (len < TELEPLOT_BIN_HEADER_SIZE || pkt[0] != TELEPLOT_BIN_MAGIC0 ||
+        pkt[1] != TELEPLOT_BIN_MAGIC1 || pkt[2] != TELEPLOT_BIN_VERSION) {
+        return -1;
+    }
+
+    const uint8_t *p = pkt + TELEPLOT_BIN_HEADER_SIZE;
+    const uint8_t *end = pkt + len;
+
+    switch (pkt[3]) {
+    case TELEPLOT_BIN_PKT_DICT:
+        return decode_dict(dict, p, end);
+    case TELEPLOT_BIN_PKT_DATA:
+        return decode_data(dict, p, end, out, out_size);
+    default:
+        return -1;
+    }
+}
@@ -0,0 +1,156 @@
+#include "teleplot_format.h"
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+static const uint32_t s_pow10[TELEPLOT_FORMAT_MAX_DECIMALS + 1] = {
+    1u, 10u, 100u, 1000u, 10000u, 100000u,
+    1000000u, 10000000u, 100000000u, 1000000000u,
+};
+
+// Zapisuje cyfry `v` od końca bufora tmp, z dopełnieniem zerami do `min_digits`
+static char *put_digits(char *end, uint64_t v, int min_digits) {
+    char *p = end;
+    // Szybka ścieżka 32-bitowa - dzielenie 64-bitowe to wywołanie biblioteczne na RISC-V
+    while (v > UINT32_MAX) {
+        *--p = (char)('0' + v % 10);
+        v /= 10;
+        min_digits--;
+    }
+    uint32_t v32 = (uint32_t)v;
+    do {
+        *--p = (char)('0' + v32 % 10);
+        v32 /= 10;
+        min_digits--;
+    } while (v32 != 0);
+    while (min_digits-- > 0) {
+        *--p = '0';
+    }
+    return p;
+}
+
+static int put_string(char *buf, size_t size, const char *s, size_t len) {
+    if (len > size) {
+        return -1;
+    }
+    memcpy(buf, s, len);
+    return (int)len;
+}
+
+int teleplot_format_fixed(char *buf, size_t size, float value, int decimals) {
+    if (decimals < 0 || decimals > TELEPLOT_FORMAT_MAX_DECIMALS) {
+        return -1;
+    }
+
+    bool negative = signbit(value);
+    if (isnan(value)) {
+        return negative ? put_string(buf, size, "-nan", 4) : put_string(buf, size, "nan", 3);
+    }
+    if (isinf(value)) {
+        return negative ? put_string(buf, size, "-inf", 4) : put_string(buf, size, "inf", 3);
+    }
+
+    // float ma 24 bity mantysy, 10^9 < 2^30 - iloczyn mieści się dokładnie w double,
+    // więc zaokrąglenie poniżej widzi dokładną wartość dziesiętną jak printf
+    double scaled = fabs((double)value) * s_pow10[decimals];
+    if (scaled >= 18446744073709551616.0) { // 2^64
+        return -1;
+    }
+
+    uint64_t units = (uint64_t)scaled;
+    double rest = scaled - (double)units;
+    if (rest > 0.5 || (rest == 0.5 && (units & 1))) {
+        units++;
+    }
+
+    char tmp[32];
+    char *end = tmp + sizeof(tmp);
+    char *p = end;
+    if (decimals > 0) {
+        p = put_digits(p, units % s_pow10[decimals], decimals);
+        *--p = '.';
+    }
+    p = put_digits(p, units / s_pow10[decimals], 1);
+    if (negative) {
+        *--p = '-';
+    }
+
+    return put_string(buf, size, p, (size_t)(end - p));
+}
+
+// Zapisuje czas w µs jako milisekundy z trzema miejscami po przecinku
+static int format_timestamp(char *buf, size_t size, int64_t timestamp_us) {
+    if (timestamp_us < 0) {
+        return -1;
+    }
+
+    char tmp[32];
+    char *end = tmp + sizeof(tmp);
+    char *p = put_digits(end, (uint64_t)timestamp_us % 1000, 3);
+    *--p = '.';
+    p = put_digits(p, (uint64_t)timestamp_us / 1000, 1);
+    return put_string(buf, size, p, (size_t)(end - p));
+}
+
+// Wspólna część obu wariantów: nazwa, opcjonalny czas, wartość i "|g"
+static int format_line(char *buf, size_t size, const char *name, bool with_timestamp,
+                       int64_t timestamp_us, float value, int decimals) {
+    size_t name_len = strlen(name);
+    // nazwa + ':' + co najmniej jedna cyfra + "|g"
+    if (name_len + 4 > size) {
+        return -1;
+    }
+
+    memcpy(buf, name, name_len);
+    size_t pos = name_len;
+    buf[pos++] = ':';
+
+    if (with_timestamp) {
+        int n = format_timestamp(buf + pos, size - pos, timestamp_us);
+        if (n < 0 || pos + n + 4 > size) {
+            return -1;
+        }
+        pos += n;
+        buf[pos++] = ':';
+    }
+
+    int n = teleplot_format_fixed(buf + pos, size - pos - 2, value, decimals);
+    if (n < 0) {
+        return -1;
+    }
+    pos += n;
+    buf[pos++] = '|';
+    buf[pos++] = 'g';
+    return (int)pos;
+}
+
+int teleplot_format_metric(char *buf, size_t size, const char *name,
+                           float value, int decimals) {
+    return format_line(buf, size, name, false, 0, value, decimals);
+}
+
+int teleplot_format_metric_at(char *buf, size_t size, const char *name,
+                              int64_t timestamp_us, float value, int decimals) {
+    return format_line(buf, size, name, true, timestamp_us, value, decimals);
+}
+
+bool teleplot_format_append_at(char *buf, size_t size, size_t *len, const char *name,
+                               int64_t timestamp_us, float value, int decimals) {
+    // Pełny bufor: przed odejmowaniem, bo size_t by się przekręcił
+    size_t sep = *len > 0 ? 1 : 0;
+    if (*len + sep >= size) {
+        return false;
+    }
+
+    int n = format_line(buf + *len + sep, size - *len - sep, name, true,
+                        timestamp_us, value, decimals);
+    if (n < 0) {
+        return false;
+    }
+    if (sep) {
+        buf[*len] = '\n';
+    }
+    *len += sep + (size_t)n;
+    return true;
+}
@@ -9,18 +9,58 @@
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "host_ip.h"
+#include "teleplot_udp.h"
+#include "telemetry_ring.h"
+#include "teleplot_format.h"
+#include "teleplot_bin.h"
+#include "wifi_sta.h"
+#include "sched_task.h"
+#include "power_mode.h"
 
 // Konfiguracja dla Teleplot
 #define TELEPLOT_IP     HOST_IP  // Zmień na IP komputera z teleplot
 #define TELEPLOT_PORT   47269             // Domyślny port teleplot
-#define UDP_BUFFER_SIZE 256
+
+// Batchowanie: wiele linii "nazwa:czas_ms:wartość|g" w jednym datagramie (oddzielone '\n').
+// 1400 bajtów mieści się w jednej ramce WiFi bez fragmentacji IP.
+#define TELEPLOT_BATCH_SIZE        1400
+#if POWER_LOW_POWER_MODE
+// Radio budzi się co okres DTIM - jedno wysłanie na okres zamiast wielu wybudzeń
+#define TELEPLOT_BATCH_DEADLINE_MS POWER_TX_PERIOD_MS
+#define TELEPLOT_DRAIN_PERIOD_MS   POWER_TX_PERIOD_MS
+#define TELEPLOT_DEMO_PERIOD_MS    1000
+#else
+#define TELEPLOT_BATCH_DEADLINE_MS 100   // Maksymalny czas oczekiwania próbki w buforze
+#define TELEPLOT_DRAIN_PERIOD_MS   20    // Jak często zadanie wysyłające opróżnia ring
+#define TELEPLOT_DEMO_PERIOD_MS    100   // Okres przykładowych danych
+#endif
+#define TELEPLOT_DECIMALS          3     // Miejsca po przecinku w wysyłanych wartościach
+
+// Tryb binarny (teleplot_bin.h): 1 = pakiety DICT/DATA do mostka tools/teleplot_bridge.c,
+// który zamienia je z powrotem na tekst dla Teleplota. Nazwy kanałów nie są powtarzane.
+#define TELEPLOT_BINARY_MODE        0
+#define TELEPLOT_BIN_PORT           47270  // Port mostka na komputerze
+#define TELEPLOT_BIN_DICT_PERIOD_MS 5000   // Co ile powtarzać słownik (np. po restarcie mostka)
 
 static const char *UDP_TAG = "teleplot_udp";
 
+// Wspólny bufor próbek: dowolny wątek publikuje, tylko zadanie teleplot_tx czyta.
+// Wyzerowany bufor jest gotowy do użycia, więc publikować można od startu.
+static telemetry_ring_t s_ring;
+
 // Struktura do przechowywania danych UDP
 typedef struct {
     int socket_fd;
     struct sockaddr_in dest_addr;
+    char batch[TELEPLOT_BATCH_SIZE];   // Bufor datagramu w trakcie składania
+    size_t batch_len;                  // Liczba zajętych bajtów w batch
+    int64_t batch_deadline_us;         // Czas (esp_timer) wymuszonego wysłania batcha
+#if TELEPLOT_BINARY_MODE
+    teleplot_bin_dict_t dict;          // Słownik kanałów nazwa -> id
+    teleplot_bin_frame_t frame;        // Pakiet DATA składany w batch
+    bool dict_dirty;                   // Nowy kanał - słownik trzeba wysłać przed danymi
+    int64_t dict_deadline_us;          // Termin okresowego powtórzenia słownika
+#endif
 } udp_context_t;
 
 // Funkcja inicjalizująca połączenie UDP
@@ -35,89 +75,243 @@ static int init_udp_connection(udp_context_t *ctx) {
     // Konfiguracja adresu docelowego
     ctx->dest_addr.sin_addr.s_addr = inet_addr(TELEPLOT_IP);
     ctx->dest_addr.sin_family = AF_INET;
+#if TELEPLOT_BINARY_MODE
+    ctx->dest_addr.sin_port = htons(TELEPLOT_BIN_PORT);
+#else
     ctx->dest_addr.sin_port = htons(TELEPLOT_PORT);
+#endif
 
-    ESP_LOGI(UDP_TAG, "UDP socket utworzony, wysyłanie do %s:%d", TELEPLOT_IP, TELEPLOT_PORT);
+    ctx->batch_len = 0;
+    ctx->batch_deadline_us = 0;
+
+    ESP_LOGI(UDP_TAG, "UDP socket utworzony, wysyłanie do %s:%d", TELEPLOT_IP,
+             ntohs(ctx->dest_addr.sin_port));
     return 0;
 }
 
-// Funkcja wysyłająca dane do teleplot
-static void send_teleplot_data(udp_context_t *ctx, const char *name, float value) {
-    char buffer[UDP_BUFFER_SIZE];
-    
-    // Format danych dla teleplot: ">nazwa:wartość\n"
-//    int len = snprintf(buffer, sizeof(buffer), ">%s:%.3f|g", name, value);
-    int len = snprintf(buffer, sizeof(buffer), "%s:%.3f|g", name, value);
-    
-    if (len > 0 && len < sizeof(buffer)) {
-        int err = sendto(ctx->socket_fd, buffer, len, 0, 
-                        (struct sockaddr *)&ctx->dest_addr, sizeof(ctx->dest_addr));
-        if (err < 0) {
-            ESP_LOGW(UDP_TAG, "Błąd wysyłania danych: errno %d", errno);
+#if TELEPLOT_BINARY_MODE
+// Wysyła cały słownik kanałów (jeden lub kilka pakietów DICT)
+static void teleplot_send_dict(udp_context_t *ctx) {
+    static uint8_t pkt[TELEPLOT_BATCH_SIZE];
+    uint8_t next = 0;
+
+    while (next < ctx->dict.count) {
+        size_t len = teleplot_bin_write_dict(&ctx->dict, pkt, sizeof(pkt), &next);
+        if (len == 0) {
+            break;
+        }
+        if (sendto(ctx->socket_fd, pkt, len, 0,
+                   (struct sockaddr *)&ctx->dest_addr, sizeof(ctx->dest_addr)) < 0) {
+            ESP_LOGW(UDP_TAG, "Błąd wysyłania słownika: errno %d", errno);
+            return;
         }
     }
+    ctx->dict_dirty = false;
+    ctx->dict_deadline_us = esp_timer_get_time() + TELEPLOT_BIN_DICT_PERIOD_MS * 1000LL;
 }
+#endif
 
-// Główna funkcja wątku UDP
-void teleplot_udp_task(void *pvParameters) {
-    udp_context_t udp_ctx;
-    
-    ESP_LOGI(UDP_TAG, "Uruchamianie wątku Teleplot UDP...");
-    
-    // Poczekaj aż WiFi się połączy (może być potrzebne)
-    vTaskDelay(pdMS_TO_TICKS(5000));
-    
-    // Inicjalizacja połączenia UDP
-    if (init_udp_connection(&udp_ctx) != 0) {
-        ESP_LOGE(UDP_TAG, "Inicjalizacja UDP nie powiodła się");
-        vTaskDelete(NULL);
+// Wysyła zgromadzony batch jednym wywołaniem sendto()
+static void teleplot_batch_flush(udp_context_t *ctx) {
+    if (ctx->batch_len == 0) {
         return;
     }
+
+#if TELEPLOT_BINARY_MODE
+    // Mostek musi znać id kanałów zanim dostanie dane
+    if (ctx->dict_dirty || esp_timer_get_time() >= ctx->dict_deadline_us) {
+        teleplot_send_dict(ctx);
+    }
+#endif
+
+    int err = sendto(ctx->socket_fd, ctx->batch, ctx->batch_len, 0,
+                    (struct sockaddr *)&ctx->dest_addr, sizeof(ctx->dest_addr));
+    if (err < 0) {
+        ESP_LOGW(UDP_TAG, "Błąd wysyłania danych: errno %d", errno);
+    }
+    ctx->batch_len = 0;
+}
+
+#if TELEPLOT_BINARY_MODE
+// Rozpoczyna nowy pakiet DATA w buforze batcha
+static void teleplot_frame_begin(udp_context_t *ctx) {
+    teleplot_bin_frame_begin(&ctx->dict, &ctx->frame, (uint8_t *)ctx->batch,
+                             sizeof(ctx->batch));
+    ctx->batch_len = ctx->frame.len;
+    ctx->batch_deadline_us = esp_timer_get_time() + TELEPLOT_BATCH_DEADLINE_MS * 1000LL;
+}
+
+// Dopisuje próbkę (id kanału + czas + wartość) do pakietu DATA
+static void teleplot_batch_add(udp_context_t *ctx, const telemetry_sample_t *sample) {
+    const char *name = sample->name;
+    bool added;
+    int id = teleplot_bin_channel_id(&ctx->dict, name, &added);
+    if (id < 0) {
+        ESP_LOGW(UDP_TAG, "Brak miejsca w słowniku dla kanału %s", name);
+        return;
+    }
+    ctx->dict_dirty |= added;
+
+    if (ctx->batch_len == 0) {
+        teleplot_frame_begin(ctx);
+    }
+    if (!teleplot_bin_frame_add(&ctx->dict, &ctx->frame, id, sample->timestamp_us, sample->value)) {
+        teleplot_batch_flush(ctx);
+        teleplot_frame_begin(ctx);
+        teleplot_bin_frame_add(&ctx->dict, &ctx->frame, id, sample->timestamp_us, sample->value);
+    }
+    ctx->batch_len = ctx->frame.len;
+}
+#else
+// Formatowanie bezpośrednio w datagramie, bez snprintf i bufora pośredniego.
+// Czas pochodzi z momentu publikacji, więc opóźnienie batcha nie zniekształca wykresu.
+static bool teleplot_batch_append(udp_context_t *ctx, const telemetry_sample_t *sample) {
+    bool first = ctx->batch_len == 0;
+    if (!teleplot_format_append_at(ctx->batch, sizeof(ctx->batch), &ctx->batch_len, sample->name,
+                                   sample->timestamp_us, sample->value, TELEPLOT_DECIMALS)) {
+        return false;
+    }
+    if (first) {
+        ctx->batch_deadline_us = esp_timer_get_time() + TELEPLOT_BATCH_DEADLINE_MS * 1000LL;
+    }
+    return true;
+}
+
+// Dopisuje próbkę do batcha; wysyła batch, gdy kolejna linia by się nie zmieściła
+static void teleplot_batch_add(udp_context_t *ctx, const telemetry_sample_t *sample) {
+    if (teleplot_batch_append(ctx, sample)) {
+        return;
+    }
+    if (ctx->batch_len > 0) {
+        teleplot_batch_flush(ctx);
+        if (teleplot_batch_append(ctx, sample)) {
+            return;
+        }
+    }
+    ESP_LOGW(UDP_TAG, "Nie można sformatować próbki %s", sample->name);
+}
+#endif
+
+// Wysyła batch, jeśli minął termin najstarszej próbki
+static void teleplot_batch_poll(udp_context_t *ctx) {
+    if (ctx->batch_len > 0 && esp_timer_get_time() >= ctx->batch_deadline_us) {
+        teleplot_batch_flush(ctx);
+    }
+}
+
+bool teleplot_publish(const char *name, float value) {
+    return teleplot_publish_at(name, value, esp_timer_get_time());
+}
+
+bool teleplot_publish_at(const char *name, float value, int64_t timestamp_us) {
+    telemetry_sample_t sample = {
+        .name = name,
+        .value = value,
+        .timestamp_us = timestamp_us,
+    };
+    return telemetry_ring_push(&s_ring, &sample);
+}
+
+uint32_t teleplot_get_dropped_count(void) {
+    return telemetry_ring_dropped(&s_ring);
+}
+
+// Przenosi wszystkie oczekujące próbki z ringu do batcha
+static void teleplot_drain_ring(udp_context_t *ctx) {
+    telemetry_sample_t sample;
+    while (telemetry_ring_pop(&s_ring, &sample)) {
+        teleplot_batch_add(ctx, &sample);
+    }
+}
+
+// Stan zadania wysyłającego: socket i batch należą wyłącznie do niego
+static udp_context_t s_udp_ctx;     // Statycznie - bufor batcha jest za duży na stos
+static int s_tx_job = -1;
+static atomic_bool s_tx_resumed;    // Ustawiane przez obserwatora WiFi
+
+// Zadanie wysyłające - w planiście co TELEPLOT_DRAIN_PERIOD_MS, tylko gdy jest WiFi.
+// Bez sieci jest wstrzymane: ring nie jest opróżniany, próbki czekają z oryginalnym
+// czasem, a nadmiar ponad TELEMETRY_RING_SIZE trafia do licznika teleplot_dropped.
+static void teleplot_tx_job(void *arg) {
+    static uint32_t reported_dropped = 0;
+
+    if (atomic_exchange(&s_tx_resumed, false)) {
+#if TELEPLOT_BINARY_MODE
+        // Mostek mógł zostać uruchomiony ponownie w czasie przerwy
+        s_udp_ctx.dict_dirty = true;
+#endif
+    }
+
+    teleplot_drain_ring(&s_udp_ctx);
+
+    // Licznik odrzuconych próbek wysyłany tylko, gdy się zmienił
+    uint32_t dropped = teleplot_get_dropped_count();
+    if (dropped != reported_dropped) {
+        ESP_LOGW(UDP_TAG, "Ring przepełniony, odrzucono %u próbek", dropped - reported_dropped);
+        telemetry_sample_t sample = {
+            .name = "teleplot_dropped",
+            .value = (float)dropped,
+            .timestamp_us = esp_timer_get_time(),
+        };
+        teleplot_batch_add(&s_udp_ctx, &sample);
+        reported_dropped = dropped;
+    }
+
+    teleplot_batch_poll(&s_udp_ctx);
+}
+
+// Obserwator WiFi: wysyłanie rusza w chwili IP_EVENT_STA_GOT_IP
+static void teleplot_wifi_listener(bool connected, int rssi, void *arg) {
+    if (connected) {
+        atomic_store(&s_tx_resumed, true);
+    }
+    ESP_LOGI(UDP_TAG, connected ? "WiFi połączone - wysyłanie wznowione" : "Brak WiFi - wysyłanie wstrzymane");
+    sched_set_enabled(s_tx_job, connected);
+}
+
+// Zadanie generujące przykładowe dane co TELEPLOT_DEMO_PERIOD_MS - zwykły producent, bez dostępu do socketu
+static void teleplot_demo_job(void *arg) {
+    static float time_counter = 0.0;
+    static int data_counter = 0;
+
+    // Generowanie przykładowych danych do wizualizacji
+    float sine_wave = sin(time_counter * 0.1) * 100.0;
+    float cosine_wave = cos(time_counter * 0.15) * 50.0;
+    float random_data = (rand() % 100) - 50;
+    float temperature_sim = 25.0 + sin(time_counter * 0.05) * 10.0;
     
-    float time_counter = 0.0;
-    int data_counter = 0;
+    teleplot_publish("sinus", sine_wave);
+    teleplot_publish("cosinus", cosine_wave);
+    teleplot_publish("random", random_data);
+    teleplot_publish("temp", temperature_sim);
+    teleplot_publish("counter", (float)data_counter);
     
-    while (1) {
-        // Generowanie przykładowych danych do wizualizacji
-        float sine_wave = sin(time_counter * 0.1) * 100.0;
-        float cosine_wave = cos(time_counter * 0.15) * 50.0;
-        float random_data = (rand() % 100) - 50;
-        float temperature_sim = 25.0 + sin(time_counter * 0.05) * 10.0;
-        
-        // Wysyłanie danych do teleplot
-        send_teleplot_data(&udp_ctx, "sinus", sine_wave);
-        send_teleplot_data(&udp_ctx, "cosinus", cosine_wave);
-        send_teleplot_data(&udp_ctx, "random", random_data);
-        send_teleplot_data(&udp_ctx, "temp", temperature_sim);
-        send_teleplot_data(&udp_ctx, "counter", (float)data_counter);
-        
-        // Informacja o wysłanych danych co 50 iteracji
-        if (data_counter % 50 == 0) {
-            ESP_LOGI(UDP_TAG, "Wysłano dane #%d - sinus: %.2f, temp: %.2f°C", 
-                     data_counter, sine_wave, temperature_sim);
-        }
-        
-        time_counter += 1.0;
-        data_counter++;
-        
-        // Wysyłaj dane co 100ms
-        vTaskDelay(pdMS_TO_TICKS(100));
+    // Informacja o opublikowanych danych co 50 iteracji
+    if (data_counter % 50 == 0) {
+        ESP_LOGI(UDP_TAG, "Opublikowano dane #%d - sinus: %.2f, temp: %.2f°C", 
+                 data_counter, sine_wave, temperature_sim);
     }
     
-    // Zamknij socket przed zakończeniem (nigdy nie powinno się wykonać)
-    close(udp_ctx.socket_fd);
-    vTaskDelete(NULL);
+    time_counter += 1.0;
+    data_counter++;
 }
 
-// Funkcja do uruchomienia wątku teleplot
+// Rejestruje zadania Teleplot w planiście
 void start_teleplot_udp_task(void) {
-    xTaskCreate(
-        teleplot_udp_task,      // Funkcja wątku
-        "TeleplotUDP",          // Nazwa wątku
-        4096,                   // Rozmiar stosu w bajtach
-        NULL,                   // Parametry
-        5,                      // Priorytet
-        NULL                    // Handle wątku
-    );
-    ESP_LOGI(UDP_TAG, "Wątek Teleplot UDP został utworzony");
-}
\ No newline at end of file
+    ESP_LOGI(UDP_TAG, "Uruchamianie Teleplot UDP...");
+
+    // Socket UDP nie wymaga połączenia - wysyłanie i tak czeka na adres IP
+    if (init_udp_connection(&s_udp_ctx) != 0) {
+        ESP_LOGE(UDP_TAG, "Inicjalizacja UDP nie powiodła się");
+        return;
+    }
+
+    // Najpierw obserwator, potem bieżący stan - połączenie w międzyczasie nie zginie
+    s_tx_job = sched_add("teleplot_tx", TELEPLOT_DRAIN_PERIOD_MS, TELEPLOT_DRAIN_PERIOD_MS / 2,
+                         teleplot_tx_job, NULL);
+    wifi_sta_subscribe(teleplot_wifi_listener, NULL);
+    sched_set_enabled(s_tx_job, wifi_sta_is_connected());
+
+    sched_add("teleplot_demo", TELEPLOT_DEMO_PERIOD_MS, TELEPLOT_DEMO_PERIOD_MS / 10, teleplot_demo_job, NULL);
+    ESP_LOGI(UDP_TAG, "Zadania Teleplot UDP dodane do planisty");
+}
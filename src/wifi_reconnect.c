@@ -0,0 +1,41 @@
+#include "wifi_reconnect.h"
+
+#include <string.h>
+
+bool wifi_cache_valid(const wifi_cache_t *cache, const char *ssid)
+{
+    return cache->version == WIFI_CACHE_VERSION &&
+           cache->channel >= 1 && cache->channel <= 14 &&
+           strncmp(cache->ssid, ssid, sizeof(cache->ssid)) == 0;
+}
+
+void wifi_reconnect_init(wifi_reconnect_t *rc, bool cache_valid)
+{
+    rc->failures = 0;
+    rc->cache_valid = cache_valid;
+}
+
+wifi_connect_mode_t wifi_reconnect_mode(const wifi_reconnect_t *rc)
+{
+    return rc->cache_valid && rc->failures < WIFI_FAST_CONNECT_ATTEMPTS ? WIFI_CONNECT_FAST : WIFI_CONNECT_SCAN;
+}
+
+uint32_t wifi_reconnect_failed(wifi_reconnect_t *rc, uint32_t random)
+{
+    // Przesunięcie ograniczone, żeby nie przepełnić uint32_t przy długiej awarii
+    uint32_t shift = rc->failures < 16 ? rc->failures : 16;
+    uint32_t delay = (uint32_t)WIFI_BACKOFF_MIN_MS << shift;
+    if (delay > WIFI_BACKOFF_MAX_MS) {
+        delay = WIFI_BACKOFF_MAX_MS;
+    }
+    if (rc->failures < UINT32_MAX) {
+        rc->failures++;
+    }
+    return delay / 2 + random % (delay / 2 + 1);
+}
+
+void wifi_reconnect_connected(wifi_reconnect_t *rc)
+{
+    rc->failures = 0;
+    rc->cache_valid = true;
+}
@@ -0,0 +1,316 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "esp_event.h"
+#include "esp_log.h"
+#include "esp_netif.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+#include "esp_wifi.h"
+#include "nvs.h"
+#include "power_mode.h"
+#include "host_ip.h"
+#include "teleplot_udp.h"
+#include "wifi_reconnect.h"
+#include "wifi_sta.h"
+
+// Stan połączenia w grupie zdarzeń: dokładnie jeden z bitów jest ustawiony,
+// więc można czekać zarówno na połączenie, jak i na jego utratę
+#define WIFI_CONNECTED_BIT    BIT0
+#define WIFI_DISCONNECTED_BIT BIT1
+
+#define WIFI_NVS_NAMESPACE  "wifi_sta"
+#define WIFI_NVS_KEY_CACHE  "cache"
+
+static const char *TAG = "wifi station";
+
+static EventGroupHandle_t s_wifi_event_group;
+static esp_netif_t *s_netif;
+static esp_timer_handle_t s_retry_timer;
+static wifi_reconnect_t s_reconnect;
+static wifi_cache_t s_cache;
+static bool s_first_connect_done;
+
+typedef struct {
+    wifi_sta_listener_t listener;
+    void *arg;
+} wifi_listener_slot_t;
+
+static wifi_listener_slot_t s_listeners[WIFI_STA_MAX_LISTENERS];
+static portMUX_TYPE s_listeners_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Odczyt zapamiętanego AP; brak wpisu to normalna sytuacja przy pierwszym starcie
+static bool wifi_cache_load(void)
+{
+    nvs_handle_t handle;
+    if (nvs_open(WIFI_NVS_NAMESPACE, NVS_READONLY, &handle) != ESP_OK) {
+        return false;
+    }
+    size_t size = sizeof(s_cache);
+    esp_err_t err = nvs_get_blob(handle, WIFI_NVS_KEY_CACHE, &s_cache, &size);
+    nvs_close(handle);
+    return err == ESP_OK && size == sizeof(s_cache) && wifi_cache_valid(&s_cache, WIFI_SSID);
+}
+
+// Zapis tylko przy zmianie AP lub kanału - zwykłe ponowne połączenie nie zużywa flasha
+static void wifi_cache_store(const uint8_t bssid[6], uint8_t channel)
+{
+    if (s_reconnect.cache_valid && s_cache.channel == channel && memcmp(s_cache.bssid, bssid, 6) == 0) {
+        return;
+    }
+
+    memset(&s_cache, 0, sizeof(s_cache));
+    s_cache.version = WIFI_CACHE_VERSION;
+    s_cache.channel = channel;
+    memcpy(s_cache.bssid, bssid, 6);
+    strncpy(s_cache.ssid, WIFI_SSID, sizeof(s_cache.ssid) - 1);
+
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(WIFI_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (err == ESP_OK) {
+        err = nvs_set_blob(handle, WIFI_NVS_KEY_CACHE, &s_cache, sizeof(s_cache));
+        if (err == ESP_OK) {
+            err = nvs_commit(handle);
+        }
+        nvs_close(handle);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Nie można zapisać AP w NVS: %s", esp_err_to_name(err));
+    }
+}
+
+// Konfiguracja dla następnej próby: bezpośrednio do zapamiętanego AP albo pełne skanowanie
+static void wifi_apply_config(wifi_connect_mode_t mode)
+{
+    wifi_config_t wifi_config = {
+        .sta = {
+            .ssid = WIFI_SSID,
+            .password = WIFI_PASS,
+            .threshold.authmode = WIFI_AUTH_WPA2_PSK,
+#if POWER_LOW_POWER_MODE
+            .listen_interval = POWER_WIFI_LISTEN_INTERVAL,
+#endif
+        },
+    };
+    if (mode == WIFI_CONNECT_FAST) {
+        wifi_config.sta.bssid_set = true;
+        memcpy(wifi_config.sta.bssid, s_cache.bssid, 6);
+        wifi_config.sta.channel = s_cache.channel;
+        wifi_config.sta.scan_method = WIFI_FAST_SCAN;
+    } else {
+        wifi_config.sta.scan_method = WIFI_ALL_CHANNEL_SCAN;
+        wifi_config.sta.sort_method = WIFI_CONNECT_AP_BY_SIGNAL;
+    }
+    esp_err_t err = esp_wifi_set_config(WIFI_IF_STA, &wifi_config);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "esp_wifi_set_config: %s", esp_err_to_name(err));
+    }
+}
+
+static void wifi_connect(void)
+{
+    wifi_connect_mode_t mode = wifi_reconnect_mode(&s_reconnect);
+    wifi_apply_config(mode);
+    ESP_LOGI(TAG, "łączenie (%s, próba %u)", mode == WIFI_CONNECT_FAST ? "szybkie" : "skanowanie",
+             (unsigned)s_reconnect.failures + 1);
+    esp_wifi_connect();
+}
+
+// Wywoływane z wątku esp_timer po upływie opóźnienia
+static void wifi_retry_timer_cb(void *arg)
+{
+    wifi_connect();
+}
+
+#ifdef WIFI_STATIC_IP
+// Adres statyczny: bez DHCP, IP_EVENT_STA_GOT_IP przychodzi zaraz po asocjacji
+static void wifi_set_static_ip(void)
+{
+    esp_netif_ip_info_t ip_info = {
+        .ip.addr = esp_ip4addr_aton(WIFI_STATIC_IP),
+        .netmask.addr = esp_ip4addr_aton(WIFI_STATIC_NETMASK),
+        .gw.addr = esp_ip4addr_aton(WIFI_STATIC_GW),
+    };
+    ESP_ERROR_CHECK(esp_netif_dhcpc_stop(s_netif));
+    ESP_ERROR_CHECK(esp_netif_set_ip_info(s_netif, &ip_info));
+
+    esp_netif_dns_info_t dns = { 0 };
+    dns.ip.u_addr.ip4.addr = ip_info.gw.addr;
+    dns.ip.type = ESP_IPADDR_TYPE_V4;
+    esp_netif_set_dns_info(s_netif, ESP_NETIF_DNS_MAIN, &dns);
+}
+#endif
+
+// Zmiana stanu: grupa zdarzeń dla czekających, potem obserwatorzy
+static void wifi_set_connected(bool connected, int rssi)
+{
+    EventBits_t bits = xEventGroupGetBits(s_wifi_event_group);
+    bool was_connected = (bits & WIFI_CONNECTED_BIT) != 0;
+    if (connected) {
+        xEventGroupClearBits(s_wifi_event_group, WIFI_DISCONNECTED_BIT);
+        xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
+    } else {
+        xEventGroupClearBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
+        xEventGroupSetBits(s_wifi_event_group, WIFI_DISCONNECTED_BIT);
+        if (!was_connected) {
+            return;     // Kolejna nieudana próba - stan się nie zmienił
+        }
+    }
+
+    wifi_listener_slot_t listeners[WIFI_STA_MAX_LISTENERS];
+    portENTER_CRITICAL(&s_listeners_lock);
+    memcpy(listeners, s_listeners, sizeof(listeners));
+    portEXIT_CRITICAL(&s_listeners_lock);
+    for (int i = 0; i < WIFI_STA_MAX_LISTENERS; i++) {
+        if (listeners[i].listener) {
+            listeners[i].listener(connected, rssi, listeners[i].arg);
+        }
+    }
+}
+
+// Event handler dla WiFi
+static void event_handler(void* arg, esp_event_base_t event_base,
+                                int32_t event_id, void* event_data)
+{
+    if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
+        wifi_connect();
+    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_CONNECTED) {
+        if (!s_first_connect_done) {
+            ESP_LOGI(TAG, "asocjacja po %d ms od resetu", (int)(esp_timer_get_time() / 1000));
+        }
+    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
+        wifi_event_sta_disconnected_t *event = (wifi_event_sta_disconnected_t *)event_data;
+        wifi_set_connected(false, 0);
+
+        // Nigdy się nie poddajemy - tylko coraz dłużej czekamy
+        uint32_t delay_ms = wifi_reconnect_failed(&s_reconnect, esp_random());
+        ESP_LOGI(TAG, "rozłączono (powód %d), ponowna próba za %u ms", event->reason, (unsigned)delay_ms);
+        esp_timer_stop(s_retry_timer);
+        esp_timer_start_once(s_retry_timer, (uint64_t)delay_ms * 1000);
+    } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
+        ip_event_got_ip_t* event = (ip_event_got_ip_t*) event_data;
+        ESP_LOGI(TAG, "got ip:" IPSTR, IP2STR(&event->ip_info.ip));
+
+        int rssi = 0;
+        wifi_ap_record_t ap_info;
+        if (esp_wifi_sta_get_ap_info(&ap_info) == ESP_OK) {
+            wifi_cache_store(ap_info.bssid, ap_info.primary);
+            rssi = ap_info.rssi;
+        }
+
+        if (!s_first_connect_done) {
+            // Od resetu do chwili, gdy pierwszy pakiet może wyjść
+            int connect_ms = esp_timer_get_time() / 1000;
+            ESP_LOGI(TAG, "połączono %d ms od resetu (%s, %u nieudanych prób)", connect_ms,
+                     wifi_reconnect_mode(&s_reconnect) == WIFI_CONNECT_FAST ? "szybkie" : "skanowanie",
+                     (unsigned)s_reconnect.failures);
+            teleplot_publish("wifi_connect_ms", (float)connect_ms);
+            s_first_connect_done = true;
+        }
+        wifi_reconnect_connected(&s_reconnect);
+        wifi_set_connected(true, rssi);
+    }
+}
+
+void wifi_sta_start(void)
+{
+    s_wifi_event_group = xEventGroupCreate();
+    xEventGroupSetBits(s_wifi_event_group, WIFI_DISCONNECTED_BIT);
+
+    ESP_ERROR_CHECK(esp_netif_init());
+    ESP_ERROR_CHECK(esp_event_loop_create_default());
+    s_netif = esp_netif_create_default_wifi_sta();
+#ifdef WIFI_STATIC_IP
+    wifi_set_static_ip();
+#endif
+
+    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+    ESP_ERROR_CHECK(esp_wifi_init(&cfg));
+
+    const esp_timer_create_args_t retry_timer_args = {
+        .callback = wifi_retry_timer_cb,
+        .name = "wifi_retry",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&retry_timer_args, &s_retry_timer));
+
+    esp_event_handler_instance_t instance_any_id;
+    esp_event_handler_instance_t instance_got_ip;
+    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT,
+                                                        ESP_EVENT_ANY_ID,
+                                                        &event_handler,
+                                                        NULL,
+                                                        &instance_any_id));
+    ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT,
+                                                        IP_EVENT_STA_GOT_IP,
+                                                        &event_handler,
+                                                        NULL,
+                                                        &instance_got_ip));
+
+    bool cached = wifi_cache_load();
+    wifi_reconnect_init(&s_reconnect, cached);
+    if (cached) {
+        ESP_LOGI(TAG, "zapamiętany AP %02x:%02x:%02x:%02x:%02x:%02x, kanał %d",
+                 s_cache.bssid[0], s_cache.bssid[1], s_cache.bssid[2],
+                 s_cache.bssid[3], s_cache.bssid[4], s_cache.bssid[5], s_cache.channel);
+    }
+
+    // Konfiguracja trafia do wifi_connect() przy każdej próbie
+    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA) );
+    ESP_ERROR_CHECK(esp_wifi_start() );
+#if POWER_LOW_POWER_MODE
+    // Radio śpi między beaconami DTIM (listen_interval), CPU może wtedy wejść w light sleep
+    ESP_ERROR_CHECK(esp_wifi_set_ps(WIFI_PS_MAX_MODEM));
+#endif
+
+    ESP_LOGI(TAG, "wifi_sta_start finished.");
+}
+
+bool wifi_sta_subscribe(wifi_sta_listener_t listener, void *arg)
+{
+    bool added = false;
+    portENTER_CRITICAL(&s_listeners_lock);
+    for (int i = 0; i < WIFI_STA_MAX_LISTENERS && !added; i++) {
+        if (s_listeners[i].listener == NULL) {
+            s_listeners[i].listener = listener;
+            s_listeners[i].arg = arg;
+            added = true;
+        }
+    }
+    portEXIT_CRITICAL(&s_listeners_lock);
+    return added;
+}
+
+bool wifi_sta_is_connected(void)
+{
+    return (xEventGroupGetBits(s_wifi_event_group) & WIFI_CONNECTED_BIT) != 0;
+}
+
+bool wifi_sta_get_rssi(int *rssi)
+{
+    wifi_ap_record_t ap_info;
+    if (!wifi_sta_is_connected() || esp_wifi_sta_get_ap_info(&ap_info) != ESP_OK) {
+        return false;
+    }
+    *rssi = ap_info.rssi;
+    return true;
+}
+
+bool wifi_sta_wait_connected(TickType_t timeout)
+{
+    EventBits_t bits = xEventGroupWaitBits(s_wifi_event_group,
+            WIFI_CONNECTED_BIT,
+            pdFALSE,
+            pdFALSE,
+            timeout);
+    return (bits & WIFI_CONNECTED_BIT) != 0;
+}
+
+bool wifi_sta_wait_disconnected(TickType_t timeout)
+{
+    EventBits_t bits = xEventGroupWaitBits(s_wifi_event_group,
+            WIFI_DISCONNECTED_BIT,
+            pdFALSE,
+            pdFALSE,
+            timeout);
+    return (bits & WIFI_DISCONNECTED_BIT) != 0;
+}
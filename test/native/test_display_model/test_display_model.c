@@ -0,0 +1,216 @@
+#include <unity.h>
+#include <string.h>
+#include "display_model.h"
+
+static display_sources_t s_sources;
+static display_screen_t s_screen;
+static ssd1306_fb_t s_fb;
+
+void setUp(void)
+{
+    memset(&s_sources, 0, sizeof(s_sources));
+    display_screen_init(&s_screen);
+    ssd1306_fb_init(&s_fb);
+}
+
+void tearDown(void) {}
+
+// Render whatever changed since the last call, like the LCD task does
+static int render(void)
+{
+    uint32_t changed = s_sources.changed;
+    s_sources.changed = 0;
+    return display_screen_render(&s_screen, s_sources.values, changed, &s_fb);
+}
+
+static bool page_is_dirty(int page)
+{
+    return s_fb.dirty_min[page] <= s_fb.dirty_max[page];
+}
+
+static void mark_clean(void)
+{
+    // What a successful flush leaves behind
+    memset(s_fb.dirty_min, SSD1306_WIDTH, sizeof(s_fb.dirty_min));
+    memset(s_fb.dirty_max, 0, sizeof(s_fb.dirty_max));
+}
+
+static void add_default_screen(void)
+{
+    TEST_ASSERT_EQUAL(0, display_screen_add(&s_screen, 0, 16, &ssd1306_font_8x8, DISPLAY_SOURCE_CLOCK,
+                                            display_format_clock));
+    TEST_ASSERT_EQUAL(1, display_screen_add(&s_screen, 0, 32, &ssd1306_font_8x8, DISPLAY_SOURCE_TEMPERATURE,
+                                            display_format_temperature));
+    TEST_ASSERT_EQUAL(2, display_screen_add(&s_screen, 0, 48, &ssd1306_font_8x8, DISPLAY_SOURCE_WIFI,
+                                            display_format_wifi));
+}
+
+static void test_update_reports_changes_only(void)
+{
+    TEST_ASSERT_TRUE(display_sources_update(&s_sources, DISPLAY_SOURCE_TEMPERATURE, display_value_number(21.5f)));
+    TEST_ASSERT_EQUAL_HEX32(1u << DISPLAY_SOURCE_TEMPERATURE, s_sources.changed);
+
+    s_sources.changed = 0;
+    TEST_ASSERT_FALSE(display_sources_update(&s_sources, DISPLAY_SOURCE_TEMPERATURE, display_value_number(21.5f)));
+    TEST_ASSERT_EQUAL_HEX32(0, s_sources.changed);
+
+    TEST_ASSERT_TRUE(display_sources_update(&s_sources, DISPLAY_SOURCE_TEMPERATURE, display_value_none()));
+    TEST_ASSERT_FALSE(display_sources_update(&s_sources, DISPLAY_SOURCE_TEMPERATURE, display_value_none()));
+    TEST_ASSERT_FALSE(display_sources_update(&s_sources, DISPLAY_SOURCE_COUNT, display_value_integer(1)));
+}
+
+static void test_first_render_draws_every_widget(void)
+{
+    add_default_screen();
+    TEST_ASSERT_EQUAL(3, render());
+    TEST_ASSERT_EQUAL_STRING("--:--:--", s_screen.widgets[0].text);
+    TEST_ASSERT_EQUAL_STRING("Temp: --", s_screen.widgets[1].text);
+    TEST_ASSERT_EQUAL_STRING("WiFi: down", s_screen.widgets[2].text);
+    TEST_ASSERT_EQUAL(8 * 10, s_screen.widgets[2].width);
+
+    // Nothing changed: nothing drawn
+    mark_clean();
+    TEST_ASSERT_EQUAL(0, render());
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        TEST_ASSERT_FALSE(page_is_dirty(page));
+    }
+}
+
+static void test_only_changed_widget_is_redrawn(void)
+{
+    add_default_screen();
+    render();
+    mark_clean();
+
+    display_sources_update(&s_sources, DISPLAY_SOURCE_CLOCK, display_value_integer(12 * 3600 + 34 * 60 + 56));
+    TEST_ASSERT_EQUAL(1, render());
+    TEST_ASSERT_EQUAL_STRING("12:34:56", s_screen.widgets[0].text);
+    TEST_ASSERT_TRUE(page_is_dirty(2));
+    TEST_ASSERT_FALSE(page_is_dirty(4));
+    TEST_ASSERT_FALSE(page_is_dirty(6));
+}
+
+static void test_same_text_is_not_redrawn(void)
+{
+    add_default_screen();
+    display_sources_update(&s_sources, DISPLAY_SOURCE_TEMPERATURE, display_value_number(21.5f));
+    render();
+    mark_clean();
+
+    // A new reading below display precision changes the value, not the text
+    TEST_ASSERT_TRUE(display_sources_update(&s_sources, DISPLAY_SOURCE_TEMPERATURE, display_value_number(21.5125f)));
+    TEST_ASSERT_EQUAL(0, render());
+    TEST_ASSERT_FALSE(page_is_dirty(4));
+}
+
+static void test_shorter_text_clears_old_pixels(void)
+{
+    static ssd1306_fb_t reference;
+    add_default_screen();
+    display_sources_update(&s_sources, DISPLAY_SOURCE_WIFI, display_value_integer(-61));
+    render();
+    TEST_ASSERT_EQUAL_STRING("WiFi: -61 dBm", s_screen.widgets[2].text);
+
+    display_sources_update(&s_sources, DISPLAY_SOURCE_WIFI, display_value_none());
+    TEST_ASSERT_EQUAL(1, render());
+
+    // Same pixels as drawing the final texts on a blank screen
+    ssd1306_fb_init(&reference);
+    ssd1306_fb_draw_text(&reference, 0, 16, "--:--:--", &ssd1306_font_8x8);
+    ssd1306_fb_draw_text(&reference, 0, 32, "Temp: --", &ssd1306_font_8x8);
+    ssd1306_fb_draw_text(&reference, 0, 48, "WiFi: down", &ssd1306_font_8x8);
+    TEST_ASSERT_EQUAL_MEMORY(reference.buffer, s_fb.buffer, sizeof(s_fb.buffer));
+}
+
+static void test_formatters(void)
+{
+    char text[DISPLAY_WIDGET_TEXT_MAX];
+    display_value_t value = display_value_integer(23 * 3600 + 59 * 60 + 59);
+    display_format_clock(&value, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("23:59:59", text);
+
+    value = display_value_number(-3.25f);
+    display_format_temperature(&value, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("Temp: -3.2 C", text);
+
+    value = display_value_integer(-48);
+    display_format_wifi(&value, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("WiFi: -48 dBm", text);
+}
+
+static void test_screen_capacity(void)
+{
+    for (int i = 0; i < DISPLAY_MAX_WIDGETS; i++) {
+        TEST_ASSERT_EQUAL(i, display_screen_add(&s_screen, 0, 0, &ssd1306_font_5x7, DISPLAY_SOURCE_CLOCK,
+                                                display_format_clock));
+    }
+    TEST_ASSERT_EQUAL(-1, display_screen_add(&s_screen, 0, 0, &ssd1306_font_5x7, DISPLAY_SOURCE_CLOCK,
+                                             display_format_clock));
+}
+
+static display_cmd_t text_cmd(int x, int y, int w, const char *text)
+{
+    display_cmd_t cmd = { .type = DISPLAY_CMD_TEXT, .x = x, .y = y, .w = w, .text = { .font = &ssd1306_font_8x8 } };
+    strcpy(cmd.text.text, text);
+    return cmd;
+}
+
+static void test_text_command_replaces_box(void)
+{
+    static ssd1306_fb_t reference;
+    display_cmd_t cmd = text_cmd(8, 8, 0, "Status: RUNNING");
+    TEST_ASSERT_TRUE(display_apply(&cmd, &s_sources, &s_fb));
+
+    // A shorter text with the old box width leaves nothing behind
+    cmd = text_cmd(8, 8, 8 * 15, "Status: OK");
+    TEST_ASSERT_TRUE(display_apply(&cmd, &s_sources, &s_fb));
+
+    ssd1306_fb_init(&reference);
+    ssd1306_fb_draw_text(&reference, 8, 8, "Status: OK", &ssd1306_font_8x8);
+    TEST_ASSERT_EQUAL_MEMORY(reference.buffer, s_fb.buffer, sizeof(s_fb.buffer));
+}
+
+static void test_fill_and_value_commands(void)
+{
+    display_cmd_t fill = { .type = DISPLAY_CMD_FILL, .x = 0, .y = 0, .w = 4, .h = 8, .color = 1 };
+    TEST_ASSERT_TRUE(display_apply(&fill, &s_sources, &s_fb));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, s_fb.buffer[3]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, s_fb.buffer[4]);
+
+    // Values only touch the sources; the screen renders them
+    display_cmd_t value = {
+        .type = DISPLAY_CMD_VALUE,
+        .update = { .source = DISPLAY_SOURCE_WIFI, .value = display_value_integer(-70) },
+    };
+    TEST_ASSERT_FALSE(display_apply(&value, &s_sources, &s_fb));
+    TEST_ASSERT_EQUAL_HEX32(1u << DISPLAY_SOURCE_WIFI, s_sources.changed);
+    TEST_ASSERT_EQUAL(-70, s_sources.values[DISPLAY_SOURCE_WIFI].integer);
+}
+
+static void test_invalidate_command_marks_region(void)
+{
+    mark_clean();
+    display_cmd_t cmd = { .type = DISPLAY_CMD_INVALIDATE, .x = 10, .y = 20, .w = 5, .h = 10 };
+    TEST_ASSERT_TRUE(display_apply(&cmd, &s_sources, &s_fb));
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        bool covered = page == 2 || page == 3;
+        TEST_ASSERT_EQUAL(covered, page_is_dirty(page));
+        TEST_ASSERT_EQUAL(covered, s_fb.stale_min[page] == 10 && s_fb.stale_max[page] == 14);
+    }
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_update_reports_changes_only);
+    RUN_TEST(test_first_render_draws_every_widget);
+    RUN_TEST(test_only_changed_widget_is_redrawn);
+    RUN_TEST(test_same_text_is_not_redrawn);
+    RUN_TEST(test_shorter_text_clears_old_pixels);
+    RUN_TEST(test_formatters);
+    RUN_TEST(test_screen_capacity);
+    RUN_TEST(test_text_command_replaces_box);
+    RUN_TEST(test_fill_and_value_commands);
+    RUN_TEST(test_invalidate_command_marks_region);
+    return UNITY_END();
+}
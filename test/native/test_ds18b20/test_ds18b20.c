@@ -0,0 +1,468 @@
+#include <unity.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ds18b20_proto.h"
+
+// Host fake of a 1-Wire bus: every device is a bit-level state machine and
+// reads are the wired-AND of all devices still taking part in the transaction.
+
+#define FAKE_MAX_DEVICES 8
+
+typedef enum {
+    FAKE_ROM_CMD,
+    FAKE_MATCH,
+    FAKE_SEARCH_ID,
+    FAKE_SEARCH_CMP,
+    FAKE_SEARCH_DIR,
+    FAKE_FUNC_CMD,
+    FAKE_SCRATCHPAD_OUT,
+    FAKE_SCRATCHPAD_IN,
+    FAKE_IDLE,
+} fake_state_t;
+
+typedef struct {
+    uint8_t rom[8];
+    uint8_t scratchpad[DS18B20_SCRATCHPAD_SIZE];
+    fake_state_t state;
+    bool active;
+    int bit;
+    uint8_t cmd;
+    int conversions;
+    uint8_t eeprom[3];      // TH, TL, configuration
+} fake_device_t;
+
+typedef struct {
+    onewire_bus_t bus;
+    fake_device_t devices[FAKE_MAX_DEVICES];
+    size_t count;
+} fake_bus_t;
+
+static fake_bus_t s_fake;
+
+static int rom_bit(const fake_device_t *dev, int n) {
+    return (dev->rom[n / 8] >> (n % 8)) & 1;
+}
+
+static bool fake_reset(onewire_bus_t *bus) {
+    fake_bus_t *fake = (fake_bus_t *)bus;
+    for (size_t i = 0; i < fake->count; i++) {
+        fake_device_t *dev = &fake->devices[i];
+        dev->state = FAKE_ROM_CMD;
+        dev->active = true;
+        dev->bit = 0;
+        dev->cmd = 0;
+    }
+    return fake->count > 0;
+}
+
+// Collects a command byte LSB first, returns true once all 8 bits arrived
+static bool fake_collect_cmd(fake_device_t *dev, int bit) {
+    dev->cmd |= bit << dev->bit++;
+    return dev->bit == 8;
+}
+
+static void fake_write_bit(onewire_bus_t *bus, int bit) {
+    fake_bus_t *fake = (fake_bus_t *)bus;
+    for (size_t i = 0; i < fake->count; i++) {
+        fake_device_t *dev = &fake->devices[i];
+        if (!dev->active) {
+            continue;
+        }
+        switch (dev->state) {
+        case FAKE_ROM_CMD:
+            if (fake_collect_cmd(dev, bit)) {
+                dev->bit = 0;
+                if (dev->cmd == ONEWIRE_CMD_SEARCH_ROM) {
+                    dev->state = FAKE_SEARCH_ID;
+                } else if (dev->cmd == ONEWIRE_CMD_MATCH_ROM) {
+                    dev->state = FAKE_MATCH;
+                } else if (dev->cmd == ONEWIRE_CMD_SKIP_ROM) {
+                    dev->state = FAKE_FUNC_CMD;
+                } else {
+                    dev->state = FAKE_IDLE;
+                }
+                dev->cmd = 0;
+            }
+            break;
+        case FAKE_MATCH:
+            if (bit != rom_bit(dev, dev->bit)) {
+                dev->active = false;
+            } else if (++dev->bit == 64) {
+                dev->bit = 0;
+                dev->state = FAKE_FUNC_CMD;
+            }
+            break;
+        case FAKE_SEARCH_DIR:
+            if (bit != rom_bit(dev, dev->bit)) {
+                dev->active = false; // Lost this branch of the search tree
+            } else {
+                dev->bit++;
+                dev->state = dev->bit == 64 ? FAKE_IDLE : FAKE_SEARCH_ID;
+            }
+            break;
+        case FAKE_FUNC_CMD:
+            if (fake_collect_cmd(dev, bit)) {
+                dev->bit = 0;
+                if (dev->cmd == DS18B20_CMD_CONVERT_T) {
+                    dev->conversions++;
+                    dev->state = FAKE_IDLE;
+                } else if (dev->cmd == DS18B20_CMD_READ_SCRATCHPAD) {
+                    dev->state = FAKE_SCRATCHPAD_OUT;
+                } else if (dev->cmd == DS18B20_CMD_WRITE_SCRATCHPAD) {
+                    dev->state = FAKE_SCRATCHPAD_IN;
+                } else if (dev->cmd == DS18B20_CMD_COPY_SCRATCHPAD) {
+                    memcpy(dev->eeprom, &dev->scratchpad[2], sizeof(dev->eeprom));
+                    dev->state = FAKE_IDLE;
+                } else {
+                    dev->state = FAKE_IDLE;
+                }
+            }
+            break;
+        case FAKE_SCRATCHPAD_IN: {
+            // TH, TL and configuration land in scratchpad bytes 2-4
+            uint8_t *byte = &dev->scratchpad[2 + dev->bit / 8];
+            uint8_t mask = 1 << (dev->bit % 8);
+            *byte = bit ? (*byte | mask) : (*byte & ~mask);
+            if (++dev->bit == 24) {
+                dev->scratchpad[8] = onewire_crc8(dev->scratchpad, 8);
+                dev->state = FAKE_IDLE;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+}
+
+static int fake_read_bit(onewire_bus_t *bus) {
+    fake_bus_t *fake = (fake_bus_t *)bus;
+    int line = 1; // Pull-up
+    for (size_t i = 0; i < fake->count; i++) {
+        fake_device_t *dev = &fake->devices[i];
+        if (!dev->active) {
+            continue;
+        }
+        int out = 1;
+        switch (dev->state) {
+        case FAKE_SEARCH_ID:
+            out = rom_bit(dev, dev->bit);
+            dev->state = FAKE_SEARCH_CMP;
+            break;
+        case FAKE_SEARCH_CMP:
+            out = !rom_bit(dev, dev->bit);
+            dev->state = FAKE_SEARCH_DIR;
+            break;
+        case FAKE_SCRATCHPAD_OUT:
+            if (dev->bit < DS18B20_SCRATCHPAD_SIZE * 8) {
+                out = (dev->scratchpad[dev->bit / 8] >> (dev->bit % 8)) & 1;
+                dev->bit++;
+            }
+            break;
+        default:
+            break;
+        }
+        line &= out;
+    }
+    return line;
+}
+
+static void fake_write_bytes(onewire_bus_t *bus, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        for (int b = 0; b < 8; b++) {
+            fake_write_bit(bus, (data[i] >> b) & 1);
+        }
+    }
+}
+
+static void fake_read_bytes(onewire_bus_t *bus, uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        data[i] = 0;
+        for (int b = 0; b < 8; b++) {
+            data[i] |= fake_read_bit(bus) << b;
+        }
+    }
+}
+
+// Adds a device with a valid ROM CRC and a scratchpad holding raw_temp
+static fake_device_t *fake_add(uint8_t family, uint64_t serial, int16_t raw_temp) {
+    fake_device_t *dev = &s_fake.devices[s_fake.count++];
+    dev->rom[0] = family;
+    for (int i = 1; i < 7; i++) {
+        dev->rom[i] = (uint8_t)(serial >> (8 * (i - 1)));
+    }
+    dev->rom[7] = onewire_crc8(dev->rom, 7);
+
+    memset(dev->scratchpad, 0, sizeof(dev->scratchpad));
+    dev->scratchpad[0] = (uint8_t)raw_temp;
+    dev->scratchpad[1] = (uint8_t)(raw_temp >> 8);
+    dev->scratchpad[4] = 0x7F; // 12-bit configuration
+    dev->scratchpad[8] = onewire_crc8(dev->scratchpad, 8);
+    return dev;
+}
+
+static bool found(uint8_t roms[][8], size_t count, const uint8_t rom[8]) {
+    for (size_t i = 0; i < count; i++) {
+        if (memcmp(roms[i], rom, 8) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void setUp(void)
+{
+    memset(&s_fake, 0, sizeof(s_fake));
+    s_fake.bus.reset = fake_reset;
+    s_fake.bus.write_bit = fake_write_bit;
+    s_fake.bus.read_bit = fake_read_bit;
+    s_fake.bus.write_bytes = fake_write_bytes;
+    s_fake.bus.read_bytes = fake_read_bytes;
+}
+
+void tearDown(void)
+{
+}
+
+static void test_crc8_known_rom(void)
+{
+    // ROM code from the Maxim AN27 example
+    const uint8_t rom[8] = { 0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xA2 };
+    TEST_ASSERT_EQUAL_HEX8(0xA2, onewire_crc8(rom, 7));
+    TEST_ASSERT_EQUAL_HEX8(0x00, onewire_crc8(rom, 8));
+}
+
+// Bitwise reference implementation the lookup table must reproduce
+static uint8_t crc8_bitwise(const uint8_t *data, size_t len)
+{
+    uint8_t crc = 0;
+    for (size_t i = 0; i < len; i++) {
+        uint8_t inbyte = data[i];
+        for (int j = 0; j < 8; j++) {
+            uint8_t mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if (mix) crc ^= 0x8C;
+            inbyte >>= 1;
+        }
+    }
+    return crc;
+}
+
+static void test_crc8_table_matches_bitwise(void)
+{
+    uint8_t data[32];
+    srand(1234);
+    for (int iter = 0; iter < 10000; iter++) {
+        size_t len = rand() % sizeof(data);
+        for (size_t i = 0; i < len; i++) {
+            data[i] = rand();
+        }
+        TEST_ASSERT_EQUAL_HEX8(crc8_bitwise(data, len), onewire_crc8(data, len));
+    }
+}
+
+static void test_rom_valid(void)
+{
+    uint8_t rom[8] = { 0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xA2 };
+    TEST_ASSERT_TRUE(onewire_rom_valid(rom));
+    rom[3] ^= 0x10;
+    TEST_ASSERT_FALSE(onewire_rom_valid(rom));
+}
+
+static void test_search_finds_all_devices(void)
+{
+    const uint64_t serials[] = { 0x000000000001ULL, 0x800000000000ULL, 0x123456789ABCULL,
+                                 0x123456789ABDULL, 0xFFFFFFFFFFFFULL };
+    const size_t n = sizeof(serials) / sizeof(serials[0]);
+    for (size_t i = 0; i < n; i++) {
+        fake_add(DS18B20_FAMILY_CODE, serials[i], 0);
+    }
+
+    uint8_t roms[FAKE_MAX_DEVICES][8];
+    TEST_ASSERT_EQUAL(n, ds18b20_proto_search(&s_fake.bus, roms, FAKE_MAX_DEVICES));
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_TRUE(found(roms, n, s_fake.devices[i].rom));
+    }
+}
+
+static void test_search_skips_other_families_and_bad_crc(void)
+{
+    fake_device_t *good = fake_add(DS18B20_FAMILY_CODE, 0x1111, 0);
+    fake_add(0x10, 0x2222, 0); // DS18S20 sharing the bus
+    fake_device_t *corrupt = fake_add(DS18B20_FAMILY_CODE, 0x3333, 0);
+    corrupt->rom[7] ^= 0x01;
+
+    uint8_t roms[FAKE_MAX_DEVICES][8];
+    TEST_ASSERT_EQUAL(1, ds18b20_proto_search(&s_fake.bus, roms, FAKE_MAX_DEVICES));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(good->rom, roms[0], 8);
+}
+
+static void test_search_respects_max_devices(void)
+{
+    for (int i = 0; i < 4; i++) {
+        fake_add(DS18B20_FAMILY_CODE, 0x100 + i, 0);
+    }
+    uint8_t roms[2][8];
+    TEST_ASSERT_EQUAL(2, ds18b20_proto_search(&s_fake.bus, roms, 2));
+}
+
+static void test_search_empty_bus(void)
+{
+    uint8_t roms[1][8];
+    TEST_ASSERT_EQUAL(0, ds18b20_proto_search(&s_fake.bus, roms, 1));
+}
+
+static void test_convert_all_reaches_every_device(void)
+{
+    fake_device_t *a = fake_add(DS18B20_FAMILY_CODE, 0xA, 0);
+    fake_device_t *b = fake_add(DS18B20_FAMILY_CODE, 0xB, 0);
+
+    TEST_ASSERT_EQUAL(ONEWIRE_OK, ds18b20_proto_convert_all(&s_fake.bus));
+    TEST_ASSERT_EQUAL(1, a->conversions);
+    TEST_ASSERT_EQUAL(1, b->conversions);
+}
+
+static void test_convert_all_without_devices(void)
+{
+    TEST_ASSERT_EQUAL(ONEWIRE_ERR_NO_PRESENCE, ds18b20_proto_convert_all(&s_fake.bus));
+}
+
+static void test_read_scratchpad_addresses_one_device(void)
+{
+    fake_add(DS18B20_FAMILY_CODE, 0xA, 0x0191);            // +25.0625 C
+    fake_device_t *b = fake_add(DS18B20_FAMILY_CODE, 0xB, (int16_t)0xFF5E); // -10.125 C
+    fake_add(DS18B20_FAMILY_CODE, 0xC, 0x07D0);            // +125 C
+
+    uint8_t sp[DS18B20_SCRATCHPAD_SIZE];
+    TEST_ASSERT_EQUAL(ONEWIRE_OK, ds18b20_proto_read_scratchpad(&s_fake.bus, b->rom, sp));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(b->scratchpad, sp, DS18B20_SCRATCHPAD_SIZE);
+    TEST_ASSERT_EQUAL_FLOAT(-10.125f, ds18b20_proto_temperature(sp));
+
+    TEST_ASSERT_EQUAL(ONEWIRE_OK, ds18b20_proto_read_scratchpad(&s_fake.bus, s_fake.devices[0].rom, sp));
+    TEST_ASSERT_EQUAL_FLOAT(25.0625f, ds18b20_proto_temperature(sp));
+    TEST_ASSERT_EQUAL(ONEWIRE_OK, ds18b20_proto_read_scratchpad(&s_fake.bus, s_fake.devices[2].rom, sp));
+    TEST_ASSERT_EQUAL_FLOAT(125.0f, ds18b20_proto_temperature(sp));
+}
+
+static void test_read_scratchpad_crc_error(void)
+{
+    fake_device_t *dev = fake_add(DS18B20_FAMILY_CODE, 0xA, 0x0191);
+    dev->scratchpad[0] ^= 0x04; // Bit flip on the wire
+
+    uint8_t sp[DS18B20_SCRATCHPAD_SIZE];
+    TEST_ASSERT_EQUAL(ONEWIRE_ERR_CRC, ds18b20_proto_read_scratchpad(&s_fake.bus, dev->rom, sp));
+}
+
+static void test_read_scratchpad_all_zero_rejected(void)
+{
+    // A bus stuck low reads all zeros, which passes the CRC
+    fake_device_t *dev = fake_add(DS18B20_FAMILY_CODE, 0xA, 0x0191);
+    memset(dev->scratchpad, 0, sizeof(dev->scratchpad));
+
+    uint8_t sp[DS18B20_SCRATCHPAD_SIZE];
+    TEST_ASSERT_EQUAL(ONEWIRE_ERR_DATA, ds18b20_proto_read_scratchpad(&s_fake.bus, dev->rom, sp));
+}
+
+static void test_read_scratchpad_power_on_value_rejected(void)
+{
+    // Brown-out or hot-plug: 85.0 C with valid CRC and configuration
+    fake_device_t *dev = fake_add(DS18B20_FAMILY_CODE, 0xA, DS18B20_POWER_ON_RAW);
+    dev->scratchpad[5] = DS18B20_RESERVED_5_RESET;
+    dev->scratchpad[6] = 0x0C;
+    dev->scratchpad[7] = DS18B20_RESERVED_7_RESET;
+    dev->scratchpad[8] = onewire_crc8(dev->scratchpad, 8);
+
+    uint8_t sp[DS18B20_SCRATCHPAD_SIZE];
+    TEST_ASSERT_EQUAL(ONEWIRE_ERR_DATA, ds18b20_proto_read_scratchpad(&s_fake.bus, dev->rom, sp));
+    TEST_ASSERT_TRUE(ds18b20_proto_is_power_on(sp));
+    TEST_ASSERT_EQUAL(12, ds18b20_proto_resolution(sp));
+
+    // Once a conversion has run the same bytes are a real reading
+    dev->scratchpad[0] = 0x51;
+    dev->scratchpad[8] = onewire_crc8(dev->scratchpad, 8);
+    TEST_ASSERT_EQUAL(ONEWIRE_OK, ds18b20_proto_read_scratchpad(&s_fake.bus, dev->rom, sp));
+    TEST_ASSERT_EQUAL_FLOAT(85.0625f, ds18b20_proto_temperature(sp));
+}
+
+static void test_write_scratchpad_sets_resolution(void)
+{
+    fake_device_t *a = fake_add(DS18B20_FAMILY_CODE, 0xA, 0);
+    fake_device_t *b = fake_add(DS18B20_FAMILY_CODE, 0xB, 0);
+    a->scratchpad[2] = 0x4B; // TH
+    a->scratchpad[3] = 0x46; // TL
+
+    TEST_ASSERT_EQUAL(ONEWIRE_OK, ds18b20_proto_write_scratchpad(&s_fake.bus, a->rom, 0x4B, 0x46,
+                                                                 DS18B20_CONFIG_FOR_RESOLUTION(10)));
+    uint8_t sp[DS18B20_SCRATCHPAD_SIZE];
+    TEST_ASSERT_EQUAL(ONEWIRE_OK, ds18b20_proto_read_scratchpad(&s_fake.bus, a->rom, sp));
+    TEST_ASSERT_EQUAL_HEX8(0x3F, sp[4]);
+    TEST_ASSERT_EQUAL_HEX8(0x4B, sp[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x46, sp[3]);
+    TEST_ASSERT_EQUAL(10, ds18b20_proto_resolution(sp));
+
+    // Match ROM left the other sensor alone
+    TEST_ASSERT_EQUAL(ONEWIRE_OK, ds18b20_proto_read_scratchpad(&s_fake.bus, b->rom, sp));
+    TEST_ASSERT_EQUAL(12, ds18b20_proto_resolution(sp));
+
+    TEST_ASSERT_EQUAL(ONEWIRE_OK, ds18b20_proto_copy_scratchpad(&s_fake.bus, a->rom));
+    TEST_ASSERT_EQUAL_HEX8(0x3F, a->eeprom[2]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, b->eeprom[2]);
+}
+
+static void test_write_scratchpad_broadcast(void)
+{
+    fake_device_t *a = fake_add(DS18B20_FAMILY_CODE, 0xA, 0);
+    fake_device_t *b = fake_add(DS18B20_FAMILY_CODE, 0xB, 0);
+
+    TEST_ASSERT_EQUAL(ONEWIRE_OK, ds18b20_proto_write_scratchpad(&s_fake.bus, NULL, 0, 0,
+                                                                 DS18B20_CONFIG_FOR_RESOLUTION(9)));
+    TEST_ASSERT_EQUAL_HEX8(0x1F, a->scratchpad[4]);
+    TEST_ASSERT_EQUAL_HEX8(0x1F, b->scratchpad[4]);
+}
+
+static void test_conversion_time_scales_with_resolution(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(93750, ds18b20_proto_conversion_time_us(9));
+    TEST_ASSERT_EQUAL_UINT32(187500, ds18b20_proto_conversion_time_us(10));
+    TEST_ASSERT_EQUAL_UINT32(375000, ds18b20_proto_conversion_time_us(11));
+    TEST_ASSERT_EQUAL_UINT32(750000, ds18b20_proto_conversion_time_us(12));
+    TEST_ASSERT_EQUAL_UINT32(750000, ds18b20_proto_conversion_time_us(0));
+}
+
+static void test_temperature_masks_undefined_bits(void)
+{
+    // +25.0625 C has bit 0 set, which only 12-bit mode defines
+    uint8_t sp[DS18B20_SCRATCHPAD_SIZE] = { 0x91, 0x01, 0, 0, DS18B20_CONFIG_FOR_RESOLUTION(12) };
+    TEST_ASSERT_EQUAL_FLOAT(25.0625f, ds18b20_proto_temperature(sp));
+    sp[4] = DS18B20_CONFIG_FOR_RESOLUTION(11);
+    TEST_ASSERT_EQUAL_FLOAT(25.0f, ds18b20_proto_temperature(sp));
+
+    // -10.125 C = 0xFF5E; 9 bits keeps 0.5 C steps
+    uint8_t neg[DS18B20_SCRATCHPAD_SIZE] = { 0x5E, 0xFF, 0, 0, DS18B20_CONFIG_FOR_RESOLUTION(9) };
+    TEST_ASSERT_EQUAL_FLOAT(-10.5f, ds18b20_proto_temperature(neg));
+    neg[4] = DS18B20_CONFIG_FOR_RESOLUTION(10);
+    TEST_ASSERT_EQUAL_FLOAT(-10.25f, ds18b20_proto_temperature(neg));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_crc8_known_rom);
+    RUN_TEST(test_crc8_table_matches_bitwise);
+    RUN_TEST(test_rom_valid);
+    RUN_TEST(test_search_finds_all_devices);
+    RUN_TEST(test_search_skips_other_families_and_bad_crc);
+    RUN_TEST(test_search_respects_max_devices);
+    RUN_TEST(test_search_empty_bus);
+    RUN_TEST(test_convert_all_reaches_every_device);
+    RUN_TEST(test_convert_all_without_devices);
+    RUN_TEST(test_read_scratchpad_addresses_one_device);
+    RUN_TEST(test_read_scratchpad_crc_error);
+    RUN_TEST(test_read_scratchpad_all_zero_rejected);
+    RUN_TEST(test_read_scratchpad_power_on_value_rejected);
+    RUN_TEST(test_write_scratchpad_sets_resolution);
+    RUN_TEST(test_write_scratchpad_broadcast);
+    RUN_TEST(test_conversion_time_scales_with_resolution);
+    RUN_TEST(test_temperature_masks_undefined_bits);
+    return UNITY_END();
+}
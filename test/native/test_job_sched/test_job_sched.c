@@ -0,0 +1,180 @@
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "job_sched.h"
+
+// Zegar sterowany z testu; każde wywołanie zadania "trwa" s_job_cost_us
+static int64_t s_now_us;
+static int64_t s_job_cost_us;
+static job_sched_t s_sched;
+static int s_runs[JOB_SCHED_MAX_JOBS];
+static int64_t s_last_run_us[JOB_SCHED_MAX_JOBS];
+
+static int64_t fake_clock(void) {
+    return s_now_us;
+}
+
+static void count_job(void *arg) {
+    int id = (int)(intptr_t)arg;
+    s_runs[id]++;
+    s_last_run_us[id] = s_now_us;
+    s_now_us += s_job_cost_us;
+}
+
+static int add_job(uint32_t period_ms, uint32_t slack_ms) {
+    int id = job_sched_count(&s_sched);
+    return job_sched_add(&s_sched, "job", period_ms, slack_ms, count_job, (void *)(intptr_t)id);
+}
+
+// Pętla planisty: śpi do zwróconego terminu, jak wątek na urządzeniu
+static int run_until(int64_t end_us) {
+    int wakeups = 0;
+    for (;;) {
+        int64_t next = job_sched_run_due(&s_sched, fake_clock);
+        wakeups++;
+        if (next >= end_us) {
+            s_now_us = end_us;
+            return wakeups;
+        }
+        if (next > s_now_us) {
+            s_now_us = next;
+        }
+    }
+}
+
+void setUp(void) {
+    s_sched = (job_sched_t){ 0 };
+    s_now_us = 1000000;
+    s_job_cost_us = 0;
+    for (int i = 0; i < JOB_SCHED_MAX_JOBS; i++) {
+        s_runs[i] = 0;
+        s_last_run_us[i] = 0;
+    }
+}
+
+void tearDown(void) {}
+
+static void test_runs_at_period(void) {
+    int a = add_job(100, 0);
+    int b = add_job(250, 0);
+    run_until(s_now_us + 1000000 - 1);
+    TEST_ASSERT_EQUAL_INT(10, s_runs[a]);
+    TEST_ASSERT_EQUAL_INT(4, s_runs[b]);
+    TEST_ASSERT_EQUAL_INT(0, s_sched.jobs[a].stats.jitter_max_us);
+}
+
+static void test_slack_coalesces_wakeups(void) {
+    // 1 s i 2 s z przesuniętą fazą, 100 ms zapasu: 1 s zadanie dołącza do wybudzeń 2 s
+    int a = add_job(1000, 0);
+    run_until(s_now_us + 30000);
+    int b = add_job(2000, 0);
+    int wakeups_exact = run_until(s_now_us + 10000000);
+
+    setUp();
+    a = add_job(1000, 100);
+    run_until(s_now_us + 30000);
+    b = add_job(2000, 100);
+    int wakeups_coalesced = run_until(s_now_us + 10000000);
+
+    // Pierwsze wywołania: a przed dodaniem b, b od razu po dodaniu
+    TEST_ASSERT_EQUAL_INT(11, s_runs[a]);
+    TEST_ASSERT_EQUAL_INT(6, s_runs[b]);
+    TEST_ASSERT_TRUE(wakeups_coalesced < wakeups_exact);
+    // Jitter ograniczony zapasem
+    TEST_ASSERT_TRUE(s_sched.jobs[a].stats.jitter_max_us <= 100000);
+}
+
+static void test_slack_limited_to_half_period(void) {
+    int a = add_job(100, 500);
+    TEST_ASSERT_EQUAL_INT(50000, s_sched.jobs[a].slack_us);
+}
+
+static void test_overrun_skips_missed_periods(void) {
+    int a = add_job(100, 0);
+    s_job_cost_us = 350000;     // Każde wywołanie trwa 3,5 okresu
+    run_until(s_now_us + 1000000);
+    TEST_ASSERT_TRUE(s_sched.jobs[a].stats.skipped > 0);
+    TEST_ASSERT_EQUAL_INT(350000, s_sched.jobs[a].stats.run_max_us);
+    // Terminy zostają na siatce 100 ms od pierwszego wywołania
+    TEST_ASSERT_EQUAL_INT(0, (s_sched.jobs[a].next_us - 1000000) % 100000);
+}
+
+static void test_disabled_job_does_not_wake(void) {
+    int a = add_job(100, 0);
+    job_sched_set_enabled(&s_sched, a, false);
+    TEST_ASSERT_EQUAL_INT64(INT64_MAX, job_sched_run_due(&s_sched, fake_clock));
+    TEST_ASSERT_EQUAL_INT(0, s_runs[a]);
+
+    // Wznowione rusza od razu, potem co okres
+    s_now_us += 123456;
+    job_sched_set_enabled(&s_sched, a, true);
+    TEST_ASSERT_EQUAL_INT64(s_now_us + 100000, job_sched_run_due(&s_sched, fake_clock));
+    TEST_ASSERT_EQUAL_INT(1, s_runs[a]);
+    TEST_ASSERT_EQUAL_INT64(s_now_us, s_last_run_us[a]);
+}
+
+static void test_stats(void) {
+    int a = add_job(10, 0);
+    s_job_cost_us = 1500;
+    run_until(s_now_us + 100000 - 1);
+    const job_stats_t *stats = &s_sched.jobs[a].stats;
+    TEST_ASSERT_EQUAL_INT(10, stats->runs);
+    TEST_ASSERT_EQUAL_INT(15000, stats->run_total_us);
+    TEST_ASSERT_EQUAL_INT(1500, stats->run_max_us);
+    TEST_ASSERT_EQUAL_INT(0, stats->skipped);
+}
+
+// Trzy zadania z fazami rozrzuconymi jak w osobnych wątkach uruchamianych po kolei;
+// zwraca liczbę wybudzeń w ciągu 10 s
+static uint32_t run_scattered_jobs(uint32_t window_ms) {
+    setUp();
+    job_sched_set_window(&s_sched, window_ms);
+    add_job(1000, 0);
+    run_until(s_now_us + 13000);
+    add_job(2000, 0);
+    run_until(s_now_us + 41000);
+    add_job(300, 0);
+    run_until(s_now_us + 1);
+
+    uint32_t start = s_sched.wakeups;
+    run_until(s_now_us + 10000000);
+    return s_sched.wakeups - start;
+}
+
+static void test_window_aligns_wakeups(void) {
+    uint32_t wakeups_free = run_scattered_jobs(0);
+    int runs_free = s_runs[0] + s_runs[1] + s_runs[2];
+    uint32_t wakeups_aligned = run_scattered_jobs(100);
+    int runs_aligned = s_runs[0] + s_runs[1] + s_runs[2];
+
+    // Każde wywołanie w oknie; na końcu przedziału może brakować wywołań przesuniętych za jego koniec
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL_INT(0, s_last_run_us[i] % 100000);
+        TEST_ASSERT_TRUE(s_sched.jobs[i].stats.jitter_max_us < 100000);
+    }
+    printf("wakeups in 10 s: %u free, %u with 100 ms windows\n", (unsigned)wakeups_free, (unsigned)wakeups_aligned);
+    TEST_ASSERT_TRUE(runs_aligned >= runs_free - 3);
+    TEST_ASSERT_TRUE(wakeups_aligned < wakeups_free);
+}
+
+static void test_rejects_bad_jobs(void) {
+    TEST_ASSERT_EQUAL_INT(-1, job_sched_add(&s_sched, "zero", 0, 0, count_job, NULL));
+    TEST_ASSERT_EQUAL_INT(-1, job_sched_add(&s_sched, "null", 10, 0, NULL, NULL));
+    for (int i = 0; i < JOB_SCHED_MAX_JOBS; i++) {
+        TEST_ASSERT_EQUAL_INT(i, add_job(10, 0));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, add_job(10, 0));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_runs_at_period);
+    RUN_TEST(test_slack_coalesces_wakeups);
+    RUN_TEST(test_slack_limited_to_half_period);
+    RUN_TEST(test_overrun_skips_missed_periods);
+    RUN_TEST(test_disabled_job_does_not_wake);
+    RUN_TEST(test_stats);
+    RUN_TEST(test_window_aligns_wakeups);
+    RUN_TEST(test_rejects_bad_jobs);
+    return UNITY_END();
+}
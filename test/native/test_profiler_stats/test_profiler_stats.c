@@ -0,0 +1,85 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "profiler_stats.h"
+#include "teleplot_bin.h"
+
+static profiler_t s_prof;
+
+void setUp(void) {
+    memset(&s_prof, 0, sizeof(s_prof));
+}
+
+void tearDown(void) {}
+
+static void test_channel_names(void) {
+    profiler_task_t *task = profiler_task(&s_prof, "LCD_Display_Tas");
+    TEST_ASSERT_NOT_NULL(task);
+    TEST_ASSERT_EQUAL_STRING("sys.cpu.LCD_Display_Tas", task->cpu_channel);
+    TEST_ASSERT_EQUAL_STRING("sys.stack.LCD_Display_Tas", task->stack_channel);
+    TEST_ASSERT_TRUE(strlen(task->stack_channel) <= TELEPLOT_BIN_MAX_NAME);
+
+    // Ten sam wątek - ten sam wpis, nazwy pod tym samym adresem
+    const char *channel = task->cpu_channel;
+    TEST_ASSERT_EQUAL_PTR(task, profiler_task(&s_prof, "LCD_Display_Tas"));
+    TEST_ASSERT_EQUAL_PTR(channel, profiler_task(&s_prof, "LCD_Display_Tas")->cpu_channel);
+    TEST_ASSERT_EQUAL_INT(1, s_prof.count);
+}
+
+static void test_table_full(void) {
+    char name[8];
+    for (int i = 0; i < PROFILER_MAX_TASKS; i++) {
+        snprintf(name, sizeof(name), "t%d", i);
+        TEST_ASSERT_NOT_NULL(profiler_task(&s_prof, name));
+    }
+    TEST_ASSERT_NULL(profiler_task(&s_prof, "one_more"));
+    TEST_ASSERT_NOT_NULL(profiler_task(&s_prof, "t3"));
+}
+
+static void test_cpu_percent(void) {
+    profiler_task_t *busy = profiler_task(&s_prof, "busy");
+    profiler_task_t *idle = profiler_task(&s_prof, "IDLE");
+
+    TEST_ASSERT_EQUAL_INT(0, profiler_begin(&s_prof, 1000));
+    TEST_ASSERT_TRUE(profiler_cpu_percent(busy, 100, 0, 1) < 0);
+    TEST_ASSERT_TRUE(profiler_cpu_percent(idle, 900, 0, 1) < 0);
+
+    uint32_t delta = profiler_begin(&s_prof, 11000);
+    TEST_ASSERT_EQUAL_INT(10000, delta);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 25.0f, profiler_cpu_percent(busy, 2600, delta, 1));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 75.0f, profiler_cpu_percent(idle, 8400, delta, 1));
+
+    // Dwa rdzenie: łączny licznik liczy czas jednego rdzenia
+    delta = profiler_begin(&s_prof, 21000);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 50.0f, profiler_cpu_percent(idle, 8400 + 10000, delta, 2));
+}
+
+static void test_counter_wraps(void) {
+    profiler_task_t *task = profiler_task(&s_prof, "wrap");
+    profiler_begin(&s_prof, UINT32_MAX - 999);
+    profiler_cpu_percent(task, UINT32_MAX - 99, 0, 1);
+
+    uint32_t delta = profiler_begin(&s_prof, 9000);
+    TEST_ASSERT_EQUAL_INT(10000, delta);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.0f, profiler_cpu_percent(task, 900, delta, 1));
+}
+
+static void test_recreated_task(void) {
+    profiler_task_t *task = profiler_task(&s_prof, "worker");
+    profiler_begin(&s_prof, 0);
+    profiler_cpu_percent(task, 50000, 0, 1);
+
+    // Wątek usunięty i utworzony ponownie - licznik od zera, nie "ujemny" przyrost
+    uint32_t delta = profiler_begin(&s_prof, 10000);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 20.0f, profiler_cpu_percent(task, 2000, delta, 1));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_channel_names);
+    RUN_TEST(test_table_full);
+    RUN_TEST(test_cpu_percent);
+    RUN_TEST(test_counter_wraps);
+    RUN_TEST(test_recreated_task);
+    return UNITY_END();
+}
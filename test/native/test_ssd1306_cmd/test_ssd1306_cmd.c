@@ -0,0 +1,139 @@
+#include <unity.h>
+#include <string.h>
+#include "ssd1306_fb.h"
+
+// Mock I2C bus: records each transaction as it would appear on the wire
+// after the address byte (control byte + payload).
+#define MOCK_MAX_TRANSACTIONS 32
+#define MOCK_MAX_BYTES 1100
+
+typedef struct {
+    uint8_t bytes[MOCK_MAX_BYTES];
+    size_t len;
+} mock_transaction_t;
+
+static mock_transaction_t s_log[MOCK_MAX_TRANSACTIONS];
+static size_t s_log_count;
+
+static int mock_write(void *ctx, uint8_t control, const uint8_t *bytes, size_t len)
+{
+    TEST_ASSERT_TRUE(s_log_count < MOCK_MAX_TRANSACTIONS);
+    TEST_ASSERT_TRUE(len + 1 <= MOCK_MAX_BYTES);
+    mock_transaction_t *t = &s_log[s_log_count++];
+    t->bytes[0] = control;
+    memcpy(&t->bytes[1], bytes, len);
+    t->len = len + 1;
+    return 0;
+}
+
+static const ssd1306_bus_t s_bus = { .write = mock_write };
+
+void setUp(void)
+{
+    memset(s_log, 0, sizeof(s_log));
+    s_log_count = 0;
+}
+
+void tearDown(void) {}
+
+static void test_init_is_one_command_stream(void)
+{
+    static const uint8_t expected[] = {
+        0x00,                   // Control byte: command stream
+        0xAE,                   // Display off
+        0xD5, 0x80,             // Clock divide
+        0xA8, 0x3F,             // Multiplex 64
+        0xD3, 0x00,             // Display offset
+        0x40,                   // Start line 0
+        0x8D, 0x14,             // Charge pump on
+        0x20, 0x00,             // Horizontal addressing
+        0xA1,                   // Segment remap
+        0xC8,                   // COM scan direction
+        0xDA, 0x12,             // COM pins
+        0x81, 0xCF,             // Contrast
+        0xD9, 0xF1,             // Precharge
+        0xDB, 0x40,             // VCOMH deselect
+        0xA4,                   // Resume from RAM
+        0xA6,                   // Normal display
+        0xAF,                   // Display on
+    };
+
+    TEST_ASSERT_EQUAL(0, ssd1306_cmd_init_panel(&s_bus));
+    TEST_ASSERT_EQUAL(1, s_log_count);
+    TEST_ASSERT_EQUAL(sizeof(expected), s_log[0].len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, s_log[0].bytes, sizeof(expected));
+}
+
+static void test_window_is_one_command_stream(void)
+{
+    static const uint8_t expected[] = { 0x00, 0x21, 8, 15, 0x22, 2, 2 };
+
+    TEST_ASSERT_EQUAL(0, ssd1306_cmd_set_window(&s_bus, 8, 15, 2, 2));
+    TEST_ASSERT_EQUAL(1, s_log_count);
+    TEST_ASSERT_EQUAL(sizeof(expected), s_log[0].len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expected, s_log[0].bytes, sizeof(expected));
+}
+
+static void test_scroll_commands(void)
+{
+    static const uint8_t scroll[] = { 0x00, 0x2E, 0x2D, 0x00, 4, 0x01, 7, 0, 127 };
+    static const uint8_t start_line[] = { 0x00, 0x40 | 24 };
+
+    TEST_ASSERT_EQUAL(0, ssd1306_cmd_scroll_left(&s_bus, 4, 7, 0, 127));
+    TEST_ASSERT_EQUAL(0, ssd1306_cmd_set_start_line(&s_bus, 24));
+    TEST_ASSERT_EQUAL(2, s_log_count);
+    TEST_ASSERT_EQUAL(sizeof(scroll), s_log[0].len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(scroll, s_log[0].bytes, sizeof(scroll));
+    TEST_ASSERT_EQUAL(sizeof(start_line), s_log[1].len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(start_line, s_log[1].bytes, sizeof(start_line));
+}
+
+static void test_full_flush_is_two_transactions(void)
+{
+    static ssd1306_fb_t fb;
+    ssd1306_fb_init(&fb);
+    fb.buffer[0] = 0x81;
+    fb.buffer[sizeof(fb.buffer) - 1] = 0x18;
+
+    TEST_ASSERT_EQUAL(0, ssd1306_fb_flush(&fb, &s_bus));
+
+    // One window + one data stream per page
+    TEST_ASSERT_EQUAL(2 * SSD1306_PAGES, s_log_count);
+    static const uint8_t window0[] = { 0x00, 0x21, 0, 127, 0x22, 0, 0 };
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(window0, s_log[0].bytes, sizeof(window0));
+    TEST_ASSERT_EQUAL(1 + SSD1306_WIDTH, s_log[1].len);
+    TEST_ASSERT_EQUAL_HEX8(0x40, s_log[1].bytes[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x81, s_log[1].bytes[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x18, s_log[2 * SSD1306_PAGES - 1].bytes[SSD1306_WIDTH]);
+}
+
+static void test_partial_flush_stream(void)
+{
+    static ssd1306_fb_t fb;
+    ssd1306_fb_init(&fb);
+    TEST_ASSERT_EQUAL(0, ssd1306_fb_flush(&fb, &s_bus));
+    s_log_count = 0;
+
+    ssd1306_fb_set_pixel(&fb, 10, 20, 1);   // Page 2, bit 4
+    ssd1306_fb_set_pixel(&fb, 12, 20, 1);
+    TEST_ASSERT_EQUAL(0, ssd1306_fb_flush(&fb, &s_bus));
+
+    static const uint8_t window[] = { 0x00, 0x21, 10, 12, 0x22, 2, 2 };
+    static const uint8_t data[] = { 0x40, 0x10, 0x00, 0x10 };
+    TEST_ASSERT_EQUAL(2, s_log_count);
+    TEST_ASSERT_EQUAL(sizeof(window), s_log[0].len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(window, s_log[0].bytes, sizeof(window));
+    TEST_ASSERT_EQUAL(sizeof(data), s_log[1].len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(data, s_log[1].bytes, sizeof(data));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_init_is_one_command_stream);
+    RUN_TEST(test_window_is_one_command_stream);
+    RUN_TEST(test_scroll_commands);
+    RUN_TEST(test_full_flush_is_two_transactions);
+    RUN_TEST(test_partial_flush_stream);
+    return UNITY_END();
+}
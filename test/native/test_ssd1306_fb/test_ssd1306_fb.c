@@ -0,0 +1,758 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306_fb.h"
+
+// Mock panel: applies column/page windows like the SSD1306 in horizontal
+// addressing mode, content scroll and start line, and counts what went
+// over the bus.
+typedef struct {
+    uint8_t ram[SSD1306_WIDTH * SSD1306_PAGES];
+    int col_start, col_end, page_start, page_end;
+    int col, page;
+    int start_line;
+    size_t command_bytes;
+    size_t data_bytes;
+    size_t transactions;
+    size_t scroll_steps;
+    bool no_content_scroll;     // Original SSD1306: 0x2D is ignored
+} mock_panel_t;
+
+static mock_panel_t s_panel;
+static ssd1306_fb_t s_fb;
+
+static void mock_commands(mock_panel_t *panel, const uint8_t *cmds, size_t len)
+{
+    panel->command_bytes += len;
+    for (size_t i = 0; i < len; i++) {
+        if (cmds[i] == SSD1306_SET_COLUMN_RANGE && i + 2 < len) {
+            panel->col = panel->col_start = cmds[i + 1];
+            panel->col_end = cmds[i + 2];
+            i += 2;
+        } else if (cmds[i] == SSD1306_SET_PAGE_RANGE && i + 2 < len) {
+            panel->page = panel->page_start = cmds[i + 1];
+            panel->page_end = cmds[i + 2];
+            i += 2;
+        } else if (cmds[i] == SSD1306_CONTENT_SCROLL_LEFT && i + 6 < len) {
+            if (panel->no_content_scroll) {
+                i += 6;
+                continue;
+            }
+            int x0 = cmds[i + 5], x1 = cmds[i + 6];
+            for (int page = cmds[i + 2]; page <= cmds[i + 4]; page++) {
+                uint8_t *row = &panel->ram[page * SSD1306_WIDTH];
+                uint8_t first = row[x0];
+                memmove(&row[x0], &row[x0 + 1], x1 - x0);
+                row[x1] = first;
+            }
+            panel->scroll_steps++;
+            i += 6;
+        } else if ((cmds[i] & 0xC0) == SSD1306_SET_START_LINE) {
+            panel->start_line = cmds[i] & 0x3F;
+        }
+    }
+}
+
+static void mock_data(mock_panel_t *panel, const uint8_t *data, size_t len)
+{
+    panel->data_bytes += len;
+    for (size_t i = 0; i < len; i++) {
+        panel->ram[panel->page * SSD1306_WIDTH + panel->col] = data[i];
+        if (++panel->col > panel->col_end) {
+            panel->col = panel->col_start;
+            if (++panel->page > panel->page_end) {
+                panel->page = panel->page_start;
+            }
+        }
+    }
+}
+
+static int mock_write(void *ctx, uint8_t control, const uint8_t *bytes, size_t len)
+{
+    mock_panel_t *panel = ctx;
+    panel->transactions++;
+    if (control == SSD1306_CONTROL_CMD_STREAM) {
+        mock_commands(panel, bytes, len);
+    } else if (control == SSD1306_CONTROL_DATA_STREAM) {
+        mock_data(panel, bytes, len);
+    }
+    return 0;
+}
+
+static const ssd1306_bus_t s_bus = {
+    .write = mock_write,
+    .ctx = &s_panel,
+};
+
+static void reset_counters(void)
+{
+    s_panel.command_bytes = 0;
+    s_panel.data_bytes = 0;
+    s_panel.transactions = 0;
+    s_panel.scroll_steps = 0;
+}
+
+// What the panel shows: RAM read from the start line onwards
+static void panel_visible(const mock_panel_t *panel, uint8_t *image)
+{
+    memset(image, 0, SSD1306_WIDTH * SSD1306_PAGES);
+    for (int y = 0; y < SSD1306_HEIGHT; y++) {
+        int ram_row = (y + panel->start_line) % SSD1306_HEIGHT;
+        for (int x = 0; x < SSD1306_WIDTH; x++) {
+            if (panel->ram[(ram_row / 8) * SSD1306_WIDTH + x] & (1 << (ram_row % 8))) {
+                image[(y / 8) * SSD1306_WIDTH + x] |= 1 << (y % 8);
+            }
+        }
+    }
+}
+
+// Flush and check the mock panel now shows exactly the framebuffer
+static void flush_and_verify(void)
+{
+    static uint8_t visible[SSD1306_WIDTH * SSD1306_PAGES];
+    TEST_ASSERT_EQUAL(0, ssd1306_fb_flush(&s_fb, &s_bus));
+    panel_visible(&s_panel, visible);
+    TEST_ASSERT_EQUAL_MEMORY(s_fb.buffer, visible, sizeof(visible));
+}
+
+// The LCD task's screen: static title plus a clock and a counter
+static void draw_screen(const char *clock, const char *counter)
+{
+    ssd1306_fb_clear(&s_fb);
+    ssd1306_fb_write_text(&s_fb, 0, 0, "ESP32 LCD Demo");
+    ssd1306_fb_write_text(&s_fb, 0, 16, clock);
+    ssd1306_fb_write_text(&s_fb, 0, 32, counter);
+    ssd1306_fb_write_text(&s_fb, 0, 48, "Status: RUNNING");
+}
+
+void setUp(void)
+{
+    memset(&s_panel, 0xA5, sizeof(s_panel.ram)); // Panel RAM is garbage at power-up
+    s_panel.start_line = 0;
+    s_panel.no_content_scroll = false;
+    reset_counters();
+    ssd1306_fb_init(&s_fb);
+}
+
+void tearDown(void) {}
+
+static void test_first_flush_sends_whole_panel(void)
+{
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(SSD1306_WIDTH * SSD1306_PAGES, s_panel.data_bytes);
+}
+
+static void test_unchanged_frame_sends_nothing(void)
+{
+    draw_screen("12:34:56", "Count: 1");
+    flush_and_verify();
+    reset_counters();
+
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(0, s_panel.data_bytes);
+    TEST_ASSERT_EQUAL(0, s_panel.transactions);
+}
+
+static void test_clear_and_redraw_same_content_sends_nothing(void)
+{
+    draw_screen("12:34:56", "Count: 1");
+    flush_and_verify();
+    reset_counters();
+
+    draw_screen("12:34:56", "Count: 1");
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(0, s_panel.data_bytes);
+}
+
+static void test_clock_tick_sends_changed_digit_only(void)
+{
+    draw_screen("12:34:56", "Count: 1");
+    flush_and_verify();
+    reset_counters();
+
+    // One second later: only the last digit cell (8 columns of one page) differs
+    draw_screen("12:34:57", "Count: 1");
+    flush_and_verify();
+    TEST_ASSERT_TRUE(s_panel.data_bytes <= 8);
+    TEST_ASSERT_EQUAL(6, s_panel.command_bytes);
+}
+
+static void test_typical_update_far_below_full_frame(void)
+{
+    draw_screen("12:34:56", "Count: 1");
+    flush_and_verify();
+    reset_counters();
+
+    // Clock digit and counter digit both change: two pages, two windows
+    draw_screen("12:34:57", "Count: 2");
+    flush_and_verify();
+    TEST_ASSERT_TRUE(s_panel.data_bytes <= 16);
+    TEST_ASSERT_EQUAL(12, s_panel.command_bytes);
+    printf("Typical update: %zu data + %zu command bytes (full frame: %d)\n",
+           s_panel.data_bytes, s_panel.command_bytes, SSD1306_WIDTH * SSD1306_PAGES + 6);
+}
+
+static void test_single_pixel_sends_one_byte(void)
+{
+    flush_and_verify();
+    reset_counters();
+
+    ssd1306_fb_set_pixel(&s_fb, 100, 37, 1);
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(1, s_panel.data_bytes);
+
+    // Setting an already set pixel does not dirty anything
+    reset_counters();
+    ssd1306_fb_set_pixel(&s_fb, 100, 37, 1);
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(0, s_panel.data_bytes);
+}
+
+static void test_clear_dirties_only_drawn_columns(void)
+{
+    flush_and_verify();
+    ssd1306_fb_write_text(&s_fb, 64, 8, "AB");
+    flush_and_verify();
+    reset_counters();
+
+    ssd1306_fb_clear(&s_fb);
+    TEST_ASSERT_EQUAL(SSD1306_WIDTH, s_fb.dirty_min[0]);
+    TEST_ASSERT_TRUE(s_fb.dirty_min[1] >= 64 && s_fb.dirty_max[1] < 80);
+    flush_and_verify();
+    TEST_ASSERT_TRUE(s_panel.data_bytes <= 16);
+}
+
+static int failing_write(void *ctx, uint8_t control, const uint8_t *bytes, size_t len)
+{
+    return -1;
+}
+
+static void test_failed_flush_is_retried(void)
+{
+    flush_and_verify();
+    ssd1306_fb_set_pixel(&s_fb, 0, 0, 1);
+
+    // A NACKed transaction keeps the page dirty for the next flush
+    ssd1306_bus_t failing = s_bus;
+    failing.write = failing_write;
+    TEST_ASSERT_NOT_EQUAL(0, ssd1306_fb_flush(&s_fb, &failing));
+
+    reset_counters();
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(1, s_panel.data_bytes);
+}
+
+static void test_back_buffer_swap_keeps_dirty_regions(void)
+{
+    static ssd1306_fb_t back;
+    ssd1306_fb_init(&back);
+    flush_and_verify();
+
+    // Frame N: drawn into the back buffer, swapped, not flushed yet
+    ssd1306_fb_write_text(&back, 0, 0, "A");
+    ssd1306_fb_copy_frame(&s_fb, &back);
+    TEST_ASSERT_EQUAL(SSD1306_WIDTH, back.dirty_min[0]);
+
+    // Frame N+1 drawn meanwhile; its swap merges with the pending one
+    ssd1306_fb_write_text(&back, 64, 56, "B");
+    ssd1306_fb_copy_frame(&s_fb, &back);
+
+    reset_counters();
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(2, s_panel.transactions / 2);
+    TEST_ASSERT_TRUE(s_panel.data_bytes <= 16);
+
+    // The back buffer keeps its pixels for incremental drawing
+    TEST_ASSERT_EQUAL_MEMORY(s_fb.buffer, back.buffer, sizeof(back.buffer));
+}
+
+static int fb_pixel(const ssd1306_fb_t *fb, int x, int y)
+{
+    return (fb->buffer[(y / 8) * SSD1306_WIDTH + x] >> (y % 8)) & 1;
+}
+
+// Per-pixel reference renderer: what ssd1306_fb_write_text did before the blitter
+static int draw_char_per_pixel(ssd1306_fb_t *fb, int x, int y, char c, const ssd1306_font_t *font)
+{
+    const ssd1306_glyph_t *glyph = ssd1306_font_glyph(font, c);
+    if (glyph == NULL) {
+        return 0;
+    }
+    const uint8_t *bitmap = &font->bitmap[glyph->offset];
+    for (int row = 0; row < font->height; row++) {
+        for (int col = 0; col < glyph->width; col++) {
+            if (bitmap[(row / 8) * glyph->width + col] & (1 << (row % 8))) {
+                ssd1306_fb_set_pixel(fb, x + glyph->xoff + col, y + row, 1);
+            }
+        }
+    }
+    return glyph->advance;
+}
+
+static void test_generated_8x8_matches_source_rows(void)
+{
+    // 'A' as written in tools/fonts/font8x8.txt, one byte per row, bit 0 = left column
+    static const uint8_t rows[8] = { 0x0C, 0x1E, 0x33, 0x33, 0x3F, 0x33, 0x33, 0x00 };
+    static ssd1306_fb_t fb;
+    ssd1306_fb_init(&fb);
+
+    TEST_ASSERT_EQUAL(8, ssd1306_fb_draw_char(&fb, 0, 0, 'A', &ssd1306_font_8x8));
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 8; col++) {
+            TEST_ASSERT_EQUAL((rows[row] >> col) & 1, fb_pixel(&fb, col, row));
+        }
+    }
+}
+
+static void test_fonts_cover_printable_ascii(void)
+{
+    const ssd1306_font_t *fonts[] = { &ssd1306_font_5x7, &ssd1306_font_8x8 };
+    for (size_t f = 0; f < 2; f++) {
+        for (int c = 32; c < 127; c++) {
+            const ssd1306_glyph_t *glyph = ssd1306_font_glyph(fonts[f], c);
+            TEST_ASSERT_NOT_NULL(glyph);
+            // Everything but the space has ink (lowercase and symbols are no longer blank)
+            TEST_ASSERT_TRUE(c == ' ' || glyph->width > 0);
+        }
+        TEST_ASSERT_NULL(ssd1306_font_glyph(fonts[f], '\n'));
+        TEST_ASSERT_NULL(ssd1306_font_glyph(fonts[f], 127));
+        TEST_ASSERT_NULL(ssd1306_font_glyph(fonts[f], (char)0xB0));
+    }
+
+    for (const char *c = "0123456789.-+: C"; *c; c++) {
+        TEST_ASSERT_NOT_NULL(ssd1306_font_glyph(&ssd1306_font_16x24_digits, *c));
+    }
+    TEST_ASSERT_NULL(ssd1306_font_glyph(&ssd1306_font_16x24_digits, 'x'));
+    TEST_ASSERT_EQUAL(3, ssd1306_font_16x24_digits.pages);
+}
+
+static void test_proportional_widths(void)
+{
+    // Monospace 8x8: every glyph advances a full cell
+    TEST_ASSERT_EQUAL(8 * 4, ssd1306_font_text_width(&ssd1306_font_8x8, "i.Wm"));
+
+    // Proportional 5x7: narrow glyphs take less room than wide ones
+    const ssd1306_glyph_t *i = ssd1306_font_glyph(&ssd1306_font_5x7, 'i');
+    const ssd1306_glyph_t *w = ssd1306_font_glyph(&ssd1306_font_5x7, 'W');
+    TEST_ASSERT_TRUE(i->advance < w->advance);
+    TEST_ASSERT_EQUAL(6, w->advance);
+    TEST_ASSERT_TRUE(ssd1306_font_text_width(&ssd1306_font_5x7, "Temp: 21.5 C") < 12 * 6);
+
+    // draw_text returns the pen position, matching the measured width
+    static ssd1306_fb_t fb;
+    ssd1306_fb_init(&fb);
+    TEST_ASSERT_EQUAL(10 + ssd1306_font_text_width(&ssd1306_font_16x24_digits, "23.5"),
+                      ssd1306_fb_draw_text(&fb, 10, 20, "23.5", &ssd1306_font_16x24_digits));
+}
+
+static void test_blit_matches_per_pixel_rendering(void)
+{
+    static ssd1306_fb_t blit, reference;
+    const ssd1306_font_t *fonts[] = { &ssd1306_font_5x7, &ssd1306_font_8x8, &ssd1306_font_16x24_digits };
+
+    // Every glyph, every vertical phase, over a non-empty background, plus clipped edges
+    const int xs[] = { -3, 0, 5, 60, 120, 125 };
+    for (size_t f = 0; f < 3; f++) {
+        for (int c = 32; c < 127; c++) {
+            for (int y = -20; y < SSD1306_HEIGHT; y += 3) {
+                for (size_t i = 0; i < sizeof(xs) / sizeof(xs[0]); i++) {
+                    ssd1306_fb_init(&blit);
+                    memset(blit.buffer, 0x24, sizeof(blit.buffer));
+                    reference = blit;
+
+                    int advance = ssd1306_fb_draw_char(&blit, xs[i], y, c, fonts[f]);
+                    TEST_ASSERT_EQUAL(draw_char_per_pixel(&reference, xs[i], y, c, fonts[f]), advance);
+                    TEST_ASSERT_EQUAL_MEMORY(reference.buffer, blit.buffer, sizeof(blit.buffer));
+                }
+            }
+        }
+    }
+}
+
+// Per-pixel reference for the primitives
+static void fill_rect_per_pixel(ssd1306_fb_t *fb, int x, int y, int w, int h, int color)
+{
+    for (int yy = y; yy < y + h; yy++) {
+        for (int xx = x; xx < x + w; xx++) {
+            ssd1306_fb_set_pixel(fb, xx, yy, color);
+        }
+    }
+}
+
+static void line_per_pixel(ssd1306_fb_t *fb, int x0, int y0, int x1, int y1, int color)
+{
+    int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int dy = abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int err = dx - dy;
+    while (1) {
+        ssd1306_fb_set_pixel(fb, x0, y0, color);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        int e2 = 2 * err;
+        if (e2 > -dy) {
+            err -= dy;
+            x0 += sx;
+        }
+        if (e2 < dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+static void test_fill_rect_matches_per_pixel(void)
+{
+    static ssd1306_fb_t fast, reference;
+    const int coords[] = { -5, 0, 3, 7, 8, 13, 60, 63, 70 };
+    const int sizes[] = { 0, 1, 2, 8, 9, 17, 64, 130 };
+    const size_t ncoords = sizeof(coords) / sizeof(coords[0]);
+    const size_t nsizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    for (int color = 0; color < 2; color++) {
+        for (size_t y = 0; y < ncoords; y++) {
+            for (size_t h = 0; h < nsizes; h++) {
+                for (size_t x = 0; x < ncoords; x++) {
+                    ssd1306_fb_init(&fast);
+                    memset(fast.buffer, 0x5A, sizeof(fast.buffer));
+                    reference = fast;
+
+                    ssd1306_fb_fill_rect(&fast, coords[x] * 2, coords[y], 11, sizes[h], color);
+                    fill_rect_per_pixel(&reference, coords[x] * 2, coords[y], 11, sizes[h], color);
+                    TEST_ASSERT_EQUAL_MEMORY(reference.buffer, fast.buffer, sizeof(fast.buffer));
+                }
+            }
+        }
+    }
+}
+
+static void test_line_matches_bresenham(void)
+{
+    static ssd1306_fb_t fast, reference;
+    const int points[][2] = {
+        { 0, 0 }, { 127, 63 }, { 64, 10 }, { 3, 60 }, { 100, 7 }, { 64, 32 },
+        { 65, 33 }, { 70, 32 }, { 64, 40 }, { -10, -4 }, { 140, 30 }, { 20, 70 },
+    };
+    const size_t n = sizeof(points) / sizeof(points[0]);
+
+    for (size_t a = 0; a < n; a++) {
+        for (size_t b = 0; b < n; b++) {
+            ssd1306_fb_init(&fast);
+            ssd1306_fb_init(&reference);
+            ssd1306_fb_line(&fast, points[a][0], points[a][1], points[b][0], points[b][1], 1);
+            line_per_pixel(&reference, points[a][0], points[a][1], points[b][0], points[b][1], 1);
+            TEST_ASSERT_EQUAL_MEMORY(reference.buffer, fast.buffer, sizeof(fast.buffer));
+        }
+    }
+}
+
+static void test_hline_dirties_one_page_span(void)
+{
+    flush_and_verify();
+    ssd1306_fb_hline(&s_fb, 90, 10, 20, 1);
+    for (int page = 0; page < SSD1306_PAGES; page++) {
+        if (page == 2) {
+            TEST_ASSERT_EQUAL(10, s_fb.dirty_min[page]);
+            TEST_ASSERT_EQUAL(90, s_fb.dirty_max[page]);
+        } else {
+            TEST_ASSERT_EQUAL(SSD1306_WIDTH, s_fb.dirty_min[page]);
+        }
+    }
+    reset_counters();
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(81, s_panel.data_bytes);
+
+    // Drawing it again changes nothing
+    ssd1306_fb_hline(&s_fb, 10, 90, 20, 1);
+    TEST_ASSERT_EQUAL(SSD1306_WIDTH, s_fb.dirty_min[2]);
+}
+
+static void test_scroll_left_moves_only_the_rectangle(void)
+{
+    static ssd1306_fb_t fb, reference;
+    ssd1306_fb_init(&fb);
+    for (size_t i = 0; i < sizeof(fb.buffer); i++) {
+        fb.buffer[i] = (uint8_t)(i * 37 + 11);
+    }
+    reference = fb;
+
+    ssd1306_fb_scroll_left(&fb, 20, 5, 50, 30, 3);
+    for (int y = 0; y < SSD1306_HEIGHT; y++) {
+        for (int x = 0; x < SSD1306_WIDTH; x++) {
+            int expected = fb_pixel(&reference, x, y);
+            if (x >= 20 && x < 70 && y >= 5 && y < 35) {
+                expected = x + 3 < 70 ? fb_pixel(&reference, x + 3, y) : 0;
+            }
+            TEST_ASSERT_EQUAL(expected, fb_pixel(&fb, x, y));
+        }
+    }
+}
+
+// Strip chart in the bottom half: one new column per frame
+static void draw_chart_column(int x, int value)
+{
+    ssd1306_fb_fill_rect(&s_fb, x, 32, 1, 32, 0);
+    ssd1306_fb_vline(&s_fb, x, 63 - value, 63, 1);
+}
+
+static void test_page_aligned_scroll_sends_new_column_only(void)
+{
+    s_fb.content_scroll = true;
+    ssd1306_fb_write_text(&s_fb, 0, 0, "Temp 21.5C");
+    for (int x = 0; x < SSD1306_WIDTH; x++) {
+        draw_chart_column(x, (x * 7) % 32);
+    }
+    flush_and_verify();
+
+    for (int frame = 0; frame < 50; frame++) {
+        reset_counters();
+        ssd1306_fb_scroll_left(&s_fb, 0, 32, SSD1306_WIDTH, 32, 1);
+        draw_chart_column(SSD1306_WIDTH - 1, (frame * 5) % 32);
+        flush_and_verify();
+        TEST_ASSERT_EQUAL(1, s_panel.scroll_steps);
+        TEST_ASSERT_TRUE(s_panel.data_bytes <= 4);
+    }
+}
+
+static void test_scroll_without_content_scroll_resends_columns(void)
+{
+    // Default build on an original SSD1306: no 0x2D, the panel still matches
+    TEST_ASSERT_FALSE(s_fb.content_scroll);
+    s_panel.no_content_scroll = true;
+    for (int x = 0; x < SSD1306_WIDTH; x++) {
+        draw_chart_column(x, (x * 7) % 32);
+    }
+    flush_and_verify();
+
+    for (int frame = 0; frame < 50; frame++) {
+        reset_counters();
+        ssd1306_fb_scroll_left(&s_fb, 0, 32, SSD1306_WIDTH, 32, 1);
+        draw_chart_column(SSD1306_WIDTH - 1, (frame * 5) % 32);
+        flush_and_verify();
+        TEST_ASSERT_EQUAL(0, s_panel.scroll_steps);
+        TEST_ASSERT_TRUE(s_panel.data_bytes <= 4 * SSD1306_WIDTH);
+    }
+}
+
+static void test_unaligned_scroll_is_resent(void)
+{
+    for (int x = 0; x < SSD1306_WIDTH; x++) {
+        ssd1306_fb_vline(&s_fb, x, 36, 36 + (x * 7) % 20, 1);
+    }
+    flush_and_verify();
+
+    reset_counters();
+    ssd1306_fb_scroll_left(&s_fb, 0, 35, SSD1306_WIDTH, 25, 1);
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(0, s_panel.scroll_steps);
+    TEST_ASSERT_TRUE(s_panel.data_bytes > 2 * 100);
+}
+
+static void test_long_scroll_is_resent(void)
+{
+    for (int x = 0; x < SSD1306_WIDTH; x++) {
+        draw_chart_column(x, x % 32);
+    }
+    flush_and_verify();
+
+    reset_counters();
+    ssd1306_fb_scroll_left(&s_fb, 0, 32, SSD1306_WIDTH, 32, SSD1306_HW_SCROLL_MAX_STEPS + 1);
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(0, s_panel.scroll_steps);
+}
+
+static void test_scroll_up_sends_exposed_rows_only(void)
+{
+    char line[20];
+    for (int i = 0; i < 8; i++) {
+        snprintf(line, sizeof(line), "line %d", i);
+        ssd1306_fb_write_text(&s_fb, 0, i * 8, line);
+    }
+    flush_and_verify();
+
+    // Whole text lines: one page per step
+    for (int i = 8; i < 20; i++) {
+        reset_counters();
+        ssd1306_fb_scroll_up(&s_fb, 8);
+        snprintf(line, sizeof(line), "line %d", i);
+        ssd1306_fb_write_text(&s_fb, 0, 56, line);
+        flush_and_verify();
+        TEST_ASSERT_TRUE(s_panel.data_bytes <= SSD1306_WIDTH);
+    }
+
+    // Smooth scrolling: a few rows touch at most two pages
+    for (int i = 0; i < 40; i++) {
+        reset_counters();
+        ssd1306_fb_scroll_up(&s_fb, 3);
+        ssd1306_fb_hline(&s_fb, i, i + 40, 62, 1);
+        flush_and_verify();
+        TEST_ASSERT_TRUE(s_panel.data_bytes <= 2 * SSD1306_WIDTH);
+    }
+
+    // Page-aligned scrolling still works with a shifted start line
+    s_fb.content_scroll = true;
+    for (int x = 0; x < SSD1306_WIDTH; x++) {
+        draw_chart_column(x, x % 32);
+    }
+    s_fb.start_line = s_panel.start_line = 0;
+    ssd1306_fb_scroll_up(&s_fb, 16);
+    flush_and_verify();
+    reset_counters();
+    ssd1306_fb_scroll_left(&s_fb, 0, 32, SSD1306_WIDTH, 16, 1);
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(1, s_panel.scroll_steps);
+}
+
+static int s_fail_scroll_commands;
+
+static int failing_scroll_write(void *ctx, uint8_t control, const uint8_t *bytes, size_t len)
+{
+    if (control == SSD1306_CONTROL_CMD_STREAM && len > 1 && bytes[1] == SSD1306_CONTENT_SCROLL_LEFT &&
+        s_fail_scroll_commands > 0) {
+        s_fail_scroll_commands--;
+        return -1;
+    }
+    return mock_write(ctx, control, bytes, len);
+}
+
+static void test_failed_scroll_resends_everything(void)
+{
+    s_fb.content_scroll = true;
+    for (int x = 0; x < SSD1306_WIDTH; x++) {
+        draw_chart_column(x, x % 32);
+    }
+    flush_and_verify();
+
+    ssd1306_bus_t failing = s_bus;
+    failing.write = failing_scroll_write;
+    s_fail_scroll_commands = 1;
+    ssd1306_fb_scroll_left(&s_fb, 0, 32, SSD1306_WIDTH, 32, 1);
+    TEST_ASSERT_NOT_EQUAL(0, ssd1306_fb_flush(&s_fb, &failing));
+
+    reset_counters();
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(SSD1306_WIDTH * SSD1306_PAGES, s_panel.data_bytes);
+}
+
+static void test_swapped_frames_keep_hardware_scroll(void)
+{
+    static ssd1306_fb_t back;
+    s_fb.content_scroll = true;
+    ssd1306_fb_init(&back);
+    for (int x = 0; x < SSD1306_WIDTH; x++) {
+        ssd1306_fb_vline(&back, x, 63 - x % 32, 63, 1);
+    }
+    ssd1306_fb_copy_frame(&s_fb, &back);
+    flush_and_verify();
+
+    // Two frames swapped before the flush task gets to them
+    for (int frame = 0; frame < 2; frame++) {
+        ssd1306_fb_scroll_left(&back, 0, 32, SSD1306_WIDTH, 32, 1);
+        ssd1306_fb_vline(&back, SSD1306_WIDTH - 1, 40 + frame, 63, 1);
+        ssd1306_fb_copy_frame(&s_fb, &back);
+    }
+    reset_counters();
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(2, s_panel.scroll_steps);
+    TEST_ASSERT_TRUE(s_panel.data_bytes <= 2 * 4);
+
+    // A scroll-up in the back buffer reaches the panel as a start line change
+    ssd1306_fb_scroll_up(&back, 8);
+    ssd1306_fb_copy_frame(&s_fb, &back);
+    reset_counters();
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(8, s_panel.start_line);
+    TEST_ASSERT_TRUE(s_panel.data_bytes <= SSD1306_WIDTH);
+}
+
+static void test_invalidate_resends_unchanged_region(void)
+{
+    static ssd1306_fb_t back;
+    ssd1306_fb_init(&back);
+    ssd1306_fb_write_text(&back, 0, 0, "Hello");
+    ssd1306_fb_copy_frame(&s_fb, &back);
+    flush_and_verify();
+
+    // The panel lost part of its RAM; invalidating in the back buffer reaches the flush
+    memset(&s_panel.ram[0], 0, 16);
+    ssd1306_fb_invalidate(&back, 0, 0, 16, 8);
+    ssd1306_fb_copy_frame(&s_fb, &back);
+    reset_counters();
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(16, s_panel.data_bytes);
+
+    // Once sent, the region is back to normal
+    reset_counters();
+    flush_and_verify();
+    TEST_ASSERT_EQUAL(0, s_panel.data_bytes);
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void test_benchmark_text_rendering(void)
+{
+    static ssd1306_fb_t fb;
+    const int chars = 2000000;
+    const char *text = "12:34:56 Temp 23.5C";
+    size_t text_len = strlen(text);
+    ssd1306_fb_init(&fb);
+
+    double t0 = now_seconds();
+    for (int i = 0; i < chars; i++) {
+        draw_char_per_pixel(&fb, (i % 16) * 8, ((i / 16) % 8) * 8, text[i % text_len], &ssd1306_font_8x8);
+    }
+    double t1 = now_seconds();
+    for (int i = 0; i < chars; i++) {
+        ssd1306_fb_draw_char(&fb, (i % 16) * 8, ((i / 16) % 8) * 8, text[i % text_len], &ssd1306_font_8x8);
+    }
+    double t2 = now_seconds();
+    for (int i = 0; i < chars; i++) {
+        ssd1306_fb_draw_char(&fb, (i % 16) * 8, ((i / 16) % 7) * 8 + 3, text[i % text_len], &ssd1306_font_8x8);
+    }
+    double t3 = now_seconds();
+
+    // The ratios vary with the host CPU and compiler; only the ordering is asserted
+    printf("per-pixel:       %.1f Mchar/s\n", chars / (t1 - t0) / 1e6);
+    printf("blit aligned:    %.1f Mchar/s (%.1fx)\n", chars / (t2 - t1) / 1e6, (t1 - t0) / (t2 - t1));
+    printf("blit unaligned:  %.1f Mchar/s (%.1fx)\n", chars / (t3 - t2) / 1e6, (t1 - t0) / (t3 - t2));
+    TEST_ASSERT_TRUE(t2 - t1 < t1 - t0);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_first_flush_sends_whole_panel);
+    RUN_TEST(test_unchanged_frame_sends_nothing);
+    RUN_TEST(test_clear_and_redraw_same_content_sends_nothing);
+    RUN_TEST(test_clock_tick_sends_changed_digit_only);
+    RUN_TEST(test_typical_update_far_below_full_frame);
+    RUN_TEST(test_single_pixel_sends_one_byte);
+    RUN_TEST(test_clear_dirties_only_drawn_columns);
+    RUN_TEST(test_failed_flush_is_retried);
+    RUN_TEST(test_back_buffer_swap_keeps_dirty_regions);
+    RUN_TEST(test_generated_8x8_matches_source_rows);
+    RUN_TEST(test_fonts_cover_printable_ascii);
+    RUN_TEST(test_proportional_widths);
+    RUN_TEST(test_blit_matches_per_pixel_rendering);
+    RUN_TEST(test_benchmark_text_rendering);
+    RUN_TEST(test_fill_rect_matches_per_pixel);
+    RUN_TEST(test_line_matches_bresenham);
+    RUN_TEST(test_hline_dirties_one_page_span);
+    RUN_TEST(test_scroll_left_moves_only_the_rectangle);
+    RUN_TEST(test_page_aligned_scroll_sends_new_column_only);
+    RUN_TEST(test_scroll_without_content_scroll_resends_columns);
+    RUN_TEST(test_unaligned_scroll_is_resent);
+    RUN_TEST(test_long_scroll_is_resent);
+    RUN_TEST(test_scroll_up_sends_exposed_rows_only);
+    RUN_TEST(test_failed_scroll_resends_everything);
+    RUN_TEST(test_swapped_frames_keep_hardware_scroll);
+    RUN_TEST(test_invalidate_resends_unchanged_region);
+    return UNITY_END();
+}
@@ -0,0 +1,138 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ssd1306_snapshot.h"
+
+static ssd1306_fb_t s_fb;
+static uint8_t s_pkt[SSD1306_SNAPSHOT_MAX_SIZE];
+static uint8_t s_frame[SSD1306_SNAPSHOT_FRAME_SIZE];
+
+void setUp(void)
+{
+    ssd1306_fb_init(&s_fb);
+    memset(s_frame, 0xA5, sizeof(s_frame));
+}
+
+void tearDown(void) {}
+
+static size_t round_trip(uint16_t seq)
+{
+    size_t len = ssd1306_snapshot_encode(s_fb.buffer, seq, s_pkt, sizeof(s_pkt));
+    TEST_ASSERT_TRUE(len > 0);
+    TEST_ASSERT_TRUE(len <= SSD1306_SNAPSHOT_MAX_SIZE);
+
+    uint16_t decoded_seq = 0;
+    TEST_ASSERT_EQUAL_INT(0, ssd1306_snapshot_decode(s_pkt, len, s_frame, &decoded_seq));
+    TEST_ASSERT_EQUAL_INT(seq, decoded_seq);
+    TEST_ASSERT_EQUAL_MEMORY(s_fb.buffer, s_frame, sizeof(s_frame));
+    return len;
+}
+
+static void test_blank_frame_is_tiny(void)
+{
+    size_t len = round_trip(7);
+    // 1024 zero bytes: eight runs of 130 plus the rest
+    TEST_ASSERT_TRUE(len <= SSD1306_SNAPSHOT_HEADER_SIZE + 2 * 8);
+}
+
+static void test_text_screen_round_trip(void)
+{
+    ssd1306_fb_write_text(&s_fb, 0, 0, "ESP32 LCD Demo");
+    ssd1306_fb_write_text(&s_fb, 0, 16, "Time: 12:34:56");
+    ssd1306_fb_write_text(&s_fb, 0, 32, "Temp: 21.5 C");
+    ssd1306_fb_write_text(&s_fb, 0, 48, "WiFi: -61 dBm");
+    size_t len = round_trip(0xBEEF);
+    printf("text screen: %u bytes (%u raw)\n", (unsigned)len, (unsigned)SSD1306_SNAPSHOT_FRAME_SIZE);
+    TEST_ASSERT_TRUE(len < SSD1306_SNAPSHOT_FRAME_SIZE / 2);
+}
+
+static void test_random_frame_round_trip(void)
+{
+    srand(1234);
+    for (int i = 0; i < SSD1306_SNAPSHOT_FRAME_SIZE; i++) {
+        // Mix of short and long runs to hit every boundary
+        s_fb.buffer[i] = (rand() % 4 == 0) ? 0 : (uint8_t)(rand() % 3);
+    }
+    round_trip(1);
+}
+
+static void test_worst_case_fits_max_size(void)
+{
+    // No two neighbours equal: everything goes out as literals
+    for (int i = 0; i < SSD1306_SNAPSHOT_FRAME_SIZE; i++) {
+        s_fb.buffer[i] = (uint8_t)i;
+    }
+    size_t len = round_trip(2);
+    TEST_ASSERT_EQUAL_INT(SSD1306_SNAPSHOT_MAX_SIZE, len);
+    TEST_ASSERT_EQUAL_INT(0, ssd1306_snapshot_encode(s_fb.buffer, 2, s_pkt, len - 1));
+}
+
+static void test_corrupt_packets_rejected(void)
+{
+    ssd1306_fb_write_text(&s_fb, 0, 0, "Hello");
+    size_t len = ssd1306_snapshot_encode(s_fb.buffer, 3, s_pkt, sizeof(s_pkt));
+
+    // Truncated anywhere: the frame comes up short or a run is cut
+    for (size_t n = 0; n < len; n++) {
+        TEST_ASSERT_EQUAL_INT(-1, ssd1306_snapshot_decode(s_pkt, n, s_frame, NULL));
+    }
+
+    s_pkt[0] = 'X';
+    TEST_ASSERT_EQUAL_INT(-1, ssd1306_snapshot_decode(s_pkt, len, s_frame, NULL));
+    s_pkt[0] = SSD1306_SNAPSHOT_MAGIC0;
+    s_pkt[2] = SSD1306_SNAPSHOT_VERSION + 1;
+    TEST_ASSERT_EQUAL_INT(-1, ssd1306_snapshot_decode(s_pkt, len, s_frame, NULL));
+    s_pkt[2] = SSD1306_SNAPSHOT_VERSION;
+
+    // Extra run past the end of the frame
+    s_pkt[len] = 0x80;
+    s_pkt[len + 1] = 0xFF;
+    TEST_ASSERT_EQUAL_INT(-1, ssd1306_snapshot_decode(s_pkt, len + 2, s_frame, NULL));
+    TEST_ASSERT_EQUAL_INT(0, ssd1306_snapshot_decode(s_pkt, len, s_frame, NULL));
+}
+
+static void test_pbm_image(void)
+{
+    static uint8_t image[SSD1306_SNAPSHOT_PBM_SIZE];
+    ssd1306_fb_set_pixel(&s_fb, 0, 0, 1);
+    ssd1306_fb_set_pixel(&s_fb, 9, 10, 1);
+
+    size_t len = ssd1306_snapshot_to_pbm(s_fb.buffer, image, sizeof(image));
+    const char *header = "P4\n128 64\n";
+    size_t header_len = strlen(header);
+    TEST_ASSERT_EQUAL_INT(header_len + 16 * 64, len);
+    TEST_ASSERT_EQUAL_MEMORY(header, image, header_len);
+
+    // Lit pixels are white (bit 0), everything else black
+    const uint8_t *pixels = &image[header_len];
+    TEST_ASSERT_EQUAL_HEX8(0x7F, pixels[0]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, pixels[1]);
+    TEST_ASSERT_EQUAL_HEX8(0xBF, pixels[10 * 16 + 1]);
+    TEST_ASSERT_EQUAL_HEX8(0xFF, pixels[10 * 16]);
+
+    TEST_ASSERT_EQUAL_INT(0, ssd1306_snapshot_to_pbm(s_fb.buffer, image, len - 1));
+}
+
+static void test_hash_tracks_changes(void)
+{
+    uint32_t blank = ssd1306_snapshot_hash(s_fb.buffer);
+    ssd1306_fb_set_pixel(&s_fb, 127, 63, 1);
+    uint32_t lit = ssd1306_snapshot_hash(s_fb.buffer);
+    TEST_ASSERT_NOT_EQUAL(blank, lit);
+    ssd1306_fb_set_pixel(&s_fb, 127, 63, 0);
+    TEST_ASSERT_EQUAL_HEX32(blank, ssd1306_snapshot_hash(s_fb.buffer));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_blank_frame_is_tiny);
+    RUN_TEST(test_text_screen_round_trip);
+    RUN_TEST(test_random_frame_round_trip);
+    RUN_TEST(test_worst_case_fits_max_size);
+    RUN_TEST(test_corrupt_packets_rejected);
+    RUN_TEST(test_pbm_image);
+    RUN_TEST(test_hash_tracks_changes);
+    return UNITY_END();
+}
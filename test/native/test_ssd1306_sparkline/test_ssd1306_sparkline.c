@@ -0,0 +1,220 @@
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ssd1306_sparkline.h"
+
+// Bus that only counts what a flush would put on the wire
+static size_t s_data_bytes;
+static size_t s_command_bytes;
+
+static int counting_write(void *ctx, uint8_t control, const uint8_t *bytes, size_t len)
+{
+    if (control == SSD1306_CONTROL_DATA_STREAM) {
+        s_data_bytes += len;
+    } else {
+        s_command_bytes += len;
+    }
+    return 0;
+}
+
+static const ssd1306_bus_t s_bus = {
+    .write = counting_write,
+};
+
+static ssd1306_fb_t s_fb;
+static ssd1306_sparkline_t s_chart;
+
+void setUp(void)
+{
+    ssd1306_fb_init(&s_fb);
+    s_data_bytes = 0;
+    s_command_bytes = 0;
+}
+
+void tearDown(void) {}
+
+static int fb_pixel(const ssd1306_fb_t *fb, int x, int y)
+{
+    return (fb->buffer[(y / 8) * SSD1306_WIDTH + x] >> (y % 8)) & 1;
+}
+
+static float test_signal(int i)
+{
+    return 20.0f + 3.0f * sinf(i * 0.21f) + (float)((i * 7919) % 13) * 0.1f;
+}
+
+// Full repaint of the same samples into a fresh framebuffer
+static void redraw_reference(const ssd1306_sparkline_t *chart, ssd1306_fb_t *fb)
+{
+    static ssd1306_sparkline_t copy;
+    copy = *chart;
+    copy.redraw = true;
+    ssd1306_sparkline_draw(&copy, fb);
+}
+
+static void test_samples_map_to_rows(void)
+{
+    ssd1306_sparkline_init(&s_chart, 0, 0, 4, 11, 0.0f, 10.0f);
+    ssd1306_sparkline_push(&s_chart, 0.0f);
+    ssd1306_sparkline_push(&s_chart, 10.0f);
+    ssd1306_sparkline_push(&s_chart, 5.0f);
+    ssd1306_sparkline_push(&s_chart, 99.0f);
+    ssd1306_sparkline_draw(&s_chart, &s_fb);
+
+    // Bottom row, joined up to the top, back down to the middle, clamped at the top
+    TEST_ASSERT_EQUAL(1, fb_pixel(&s_fb, 0, 10));
+    TEST_ASSERT_EQUAL(0, fb_pixel(&s_fb, 0, 9));
+    for (int y = 0; y <= 10; y++) {
+        TEST_ASSERT_EQUAL(1, fb_pixel(&s_fb, 1, y));
+    }
+    for (int y = 0; y <= 10; y++) {
+        TEST_ASSERT_EQUAL(y <= 5, fb_pixel(&s_fb, 2, y));
+        TEST_ASSERT_EQUAL(y <= 5, fb_pixel(&s_fb, 3, y));
+    }
+}
+
+static void test_partial_chart_grows_from_the_right(void)
+{
+    ssd1306_sparkline_init(&s_chart, 10, 8, 40, 16, 0.0f, 1.0f);
+    ssd1306_sparkline_push(&s_chart, 0.5f);
+    ssd1306_sparkline_draw(&s_chart, &s_fb);
+
+    for (int x = 0; x < SSD1306_WIDTH; x++) {
+        int column = 0;
+        for (int y = 0; y < SSD1306_HEIGHT; y++) {
+            column |= fb_pixel(&s_fb, x, y);
+        }
+        TEST_ASSERT_EQUAL(x == 49, column);
+    }
+}
+
+static void test_incremental_matches_full_redraw(void)
+{
+    static ssd1306_fb_t reference;
+
+    // Fixed scale, one or several samples between draws, before and after the ring wraps
+    ssd1306_sparkline_init(&s_chart, 7, 13, 60, 37, 15.0f, 25.0f);
+    memset(s_fb.buffer, 0x81, sizeof(s_fb.buffer));
+    for (int i = 0; i < 400; i++) {
+        ssd1306_sparkline_push(&s_chart, test_signal(i));
+        if (i % 3 == 0 || i > 200) {
+            ssd1306_sparkline_draw(&s_chart, &s_fb);
+            reference = s_fb;
+            redraw_reference(&s_chart, &reference);
+            TEST_ASSERT_EQUAL_MEMORY(reference.buffer, s_fb.buffer, sizeof(s_fb.buffer));
+        }
+    }
+}
+
+static void test_autoscale_grows_and_redraws(void)
+{
+    static ssd1306_fb_t reference;
+
+    ssd1306_sparkline_init(&s_chart, 0, 32, 128, 32, 0.0f, 0.0f);
+    TEST_ASSERT_TRUE(s_chart.autoscale);
+    for (int i = 0; i < 300; i++) {
+        ssd1306_sparkline_push(&s_chart, i < 150 ? test_signal(i) : test_signal(i) * 2.0f);
+        ssd1306_sparkline_draw(&s_chart, &s_fb);
+        reference = s_fb;
+        redraw_reference(&s_chart, &reference);
+        TEST_ASSERT_EQUAL_MEMORY(reference.buffer, s_fb.buffer, sizeof(s_fb.buffer));
+    }
+    TEST_ASSERT_TRUE(s_chart.max >= 2.0f * 23.0f);
+    TEST_ASSERT_TRUE(s_chart.min <= 20.0f);
+
+    // Nothing above the chart was touched
+    for (size_t i = 0; i < 4 * SSD1306_WIDTH; i++) {
+        TEST_ASSERT_EQUAL(0, s_fb.buffer[i]);
+    }
+}
+
+static void test_flat_signal_draws_middle_row(void)
+{
+    ssd1306_sparkline_init(&s_chart, 0, 0, 8, 9, 0.0f, 0.0f);
+    for (int i = 0; i < 8; i++) {
+        ssd1306_sparkline_push(&s_chart, 42.0f);
+    }
+    ssd1306_sparkline_draw(&s_chart, &s_fb);
+    for (int x = 0; x < 8; x++) {
+        TEST_ASSERT_EQUAL(1, fb_pixel(&s_fb, x, 4));
+        TEST_ASSERT_EQUAL(0, fb_pixel(&s_fb, x, 3));
+    }
+}
+
+static void test_reset_clears_rectangle(void)
+{
+    ssd1306_sparkline_init(&s_chart, 0, 0, 32, 16, -1.0f, 1.0f);
+    for (int i = 0; i < 50; i++) {
+        ssd1306_sparkline_push(&s_chart, test_signal(i) - 20.0f);
+    }
+    ssd1306_sparkline_draw(&s_chart, &s_fb);
+    ssd1306_sparkline_reset(&s_chart);
+    ssd1306_sparkline_draw(&s_chart, &s_fb);
+    for (size_t i = 0; i < sizeof(s_fb.buffer); i++) {
+        TEST_ASSERT_EQUAL(0, s_fb.buffer[i]);
+    }
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void test_benchmark_strip_chart(void)
+{
+    // Bottom half of the panel, one sample per frame
+    const int frames = 200000;
+    ssd1306_sparkline_init(&s_chart, 0, 32, 128, 32, 15.0f, 25.0f);
+    for (int i = 0; i < 128; i++) {
+        ssd1306_sparkline_push(&s_chart, test_signal(i));
+    }
+    ssd1306_sparkline_draw(&s_chart, &s_fb);
+    ssd1306_fb_flush(&s_fb, &s_bus);
+
+    double t0 = now_seconds();
+    for (int i = 0; i < frames; i++) {
+        ssd1306_sparkline_push(&s_chart, test_signal(i));
+        ssd1306_sparkline_draw(&s_chart, &s_fb);
+    }
+    double t1 = now_seconds();
+    for (int i = 0; i < frames; i++) {
+        redraw_reference(&s_chart, &s_fb);
+    }
+    double t2 = now_seconds();
+
+    printf("incremental:  %.2f us/frame\n", (t1 - t0) / frames * 1e6);
+    printf("full redraw:  %.2f us/frame\n", (t2 - t1) / frames * 1e6);
+    TEST_ASSERT_TRUE(t1 - t0 < t2 - t1);
+
+    // What one frame puts on the bus, without and with content scroll
+    for (int content_scroll = 0; content_scroll <= 1; content_scroll++) {
+        s_fb.content_scroll = content_scroll;
+        ssd1306_fb_flush(&s_fb, &s_bus);
+        s_data_bytes = 0;
+        s_command_bytes = 0;
+        ssd1306_sparkline_push(&s_chart, test_signal(frames + content_scroll));
+        ssd1306_sparkline_draw(&s_chart, &s_fb);
+        ssd1306_fb_flush(&s_fb, &s_bus);
+        printf("bus per frame (content scroll %s): %u data + %u command bytes\n", content_scroll ? "on" : "off",
+               (unsigned)s_data_bytes, (unsigned)s_command_bytes);
+    }
+    // Page-aligned chart: the panel shifts it, only the new and the oldest column are sent
+    TEST_ASSERT_TRUE(s_data_bytes <= 2 * 4);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_samples_map_to_rows);
+    RUN_TEST(test_partial_chart_grows_from_the_right);
+    RUN_TEST(test_incremental_matches_full_redraw);
+    RUN_TEST(test_autoscale_grows_and_redraws);
+    RUN_TEST(test_flat_signal_draws_middle_row);
+    RUN_TEST(test_reset_clears_rectangle);
+    RUN_TEST(test_benchmark_strip_chart);
+    return UNITY_END();
+}
@@ -0,0 +1,142 @@
+#include <unity.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <string.h>
+#include "telemetry_ring.h"
+
+#define STRESS_PRODUCERS    2
+#define STRESS_SAMPLES      200000
+
+static telemetry_ring_t s_ring;
+
+void setUp(void) {
+    // Wyzerowany bufor jest pusty i gotowy do użycia
+    memset(&s_ring, 0, sizeof(s_ring));
+}
+
+void tearDown(void) {}
+
+static bool push(int64_t timestamp_us) {
+    telemetry_sample_t sample = {
+        .name = "test",
+        .value = (float)timestamp_us,
+        .timestamp_us = timestamp_us,
+    };
+    return telemetry_ring_push(&s_ring, &sample);
+}
+
+static void test_empty_ring_pops_nothing(void) {
+    telemetry_sample_t out;
+    TEST_ASSERT_FALSE(telemetry_ring_pop(&s_ring, &out));
+    TEST_ASSERT_EQUAL_UINT32(0, telemetry_ring_dropped(&s_ring));
+}
+
+static void test_fifo_order(void) {
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(push(i));
+    }
+    telemetry_sample_t out;
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(telemetry_ring_pop(&s_ring, &out));
+        TEST_ASSERT_EQUAL_INT64(i, out.timestamp_us);
+        TEST_ASSERT_EQUAL_STRING("test", out.name);
+    }
+    TEST_ASSERT_FALSE(telemetry_ring_pop(&s_ring, &out));
+}
+
+static void test_full_ring_drops_and_counts(void) {
+    for (int i = 0; i < TELEMETRY_RING_SIZE; i++) {
+        TEST_ASSERT_TRUE(push(i));
+    }
+    TEST_ASSERT_FALSE(push(1000));
+    TEST_ASSERT_FALSE(push(1001));
+    TEST_ASSERT_EQUAL_UINT32(2, telemetry_ring_dropped(&s_ring));
+
+    // Odrzucone próbki nie nadpisały najstarszych
+    telemetry_sample_t out;
+    TEST_ASSERT_TRUE(telemetry_ring_pop(&s_ring, &out));
+    TEST_ASSERT_EQUAL_INT64(0, out.timestamp_us);
+
+    // Jeden zwolniony slot przyjmuje dokładnie jedną próbkę
+    TEST_ASSERT_TRUE(push(2000));
+    TEST_ASSERT_FALSE(push(2001));
+    TEST_ASSERT_EQUAL_UINT32(3, telemetry_ring_dropped(&s_ring));
+    for (int i = 1; i < TELEMETRY_RING_SIZE; i++) {
+        TEST_ASSERT_TRUE(telemetry_ring_pop(&s_ring, &out));
+        TEST_ASSERT_EQUAL_INT64(i, out.timestamp_us);
+    }
+    TEST_ASSERT_TRUE(telemetry_ring_pop(&s_ring, &out));
+    TEST_ASSERT_EQUAL_INT64(2000, out.timestamp_us);
+    TEST_ASSERT_FALSE(telemetry_ring_pop(&s_ring, &out));
+}
+
+static void test_wrap_around(void) {
+    // Wiele okrążeń indeksów przy niepełnym buforze
+    telemetry_sample_t out;
+    int64_t next_in = 0;
+    int64_t next_out = 0;
+    for (int round = 0; round < 10 * TELEMETRY_RING_SIZE; round++) {
+        for (int i = 0; i < 3; i++) {
+            TEST_ASSERT_TRUE(push(next_in++));
+        }
+        for (int i = 0; i < 3; i++) {
+            TEST_ASSERT_TRUE(telemetry_ring_pop(&s_ring, &out));
+            TEST_ASSERT_EQUAL_INT64(next_out++, out.timestamp_us);
+        }
+    }
+    TEST_ASSERT_FALSE(telemetry_ring_pop(&s_ring, &out));
+    TEST_ASSERT_EQUAL_UINT32(0, telemetry_ring_dropped(&s_ring));
+}
+
+// Producent ponawia odrzucone próbki, więc każda musi dotrzeć dokładnie raz
+static void *stress_producer(void *arg) {
+    int64_t producer = (int64_t)(intptr_t)arg;
+    for (int64_t seq = 0; seq < STRESS_SAMPLES; seq++) {
+        while (!push((producer << 32) | seq)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void test_two_producers_lose_and_duplicate_nothing(void) {
+    pthread_t threads[STRESS_PRODUCERS];
+    for (intptr_t p = 0; p < STRESS_PRODUCERS; p++) {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[p], NULL, stress_producer, (void *)p));
+    }
+
+    // Kolejność w obrębie jednego producenta jest zachowana: oczekujemy
+    // kolejnych numerów, więc zgubienie lub duplikat od razu wychodzi
+    int64_t expected[STRESS_PRODUCERS] = { 0 };
+    int64_t received = 0;
+    telemetry_sample_t out;
+    while (received < (int64_t)STRESS_PRODUCERS * STRESS_SAMPLES) {
+        if (!telemetry_ring_pop(&s_ring, &out)) {
+            sched_yield();
+            continue;
+        }
+        int64_t producer = out.timestamp_us >> 32;
+        int64_t seq = out.timestamp_us & 0xFFFFFFFF;
+        TEST_ASSERT_TRUE(producer >= 0 && producer < STRESS_PRODUCERS);
+        TEST_ASSERT_EQUAL_INT64(expected[producer], seq);
+        expected[producer]++;
+        received++;
+    }
+
+    for (int p = 0; p < STRESS_PRODUCERS; p++) {
+        pthread_join(threads[p], NULL);
+        TEST_ASSERT_EQUAL_INT64(STRESS_SAMPLES, expected[p]);
+    }
+    TEST_ASSERT_FALSE(telemetry_ring_pop(&s_ring, &out));
+}
+
+int main(void) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_ring_pops_nothing);
+    RUN_TEST(test_fifo_order);
+    RUN_TEST(test_full_ring_drops_and_counts);
+    RUN_TEST(test_wrap_around);
+    RUN_TEST(test_two_producers_lose_and_duplicate_nothing);
+    return UNITY_END();
+}
@@ -0,0 +1,251 @@
+#include <unity.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "teleplot_bin.h"
+
+static int s_rx = -1;
+static int s_tx = -1;
+static struct sockaddr_in s_rx_addr;
+
+void setUp(void)
+{
+    // Para socketów na localhost: s_tx udaje urządzenie, s_rx mostek
+    s_rx = socket(AF_INET, SOCK_DGRAM, 0);
+    s_tx = socket(AF_INET, SOCK_DGRAM, 0);
+
+    memset(&s_rx_addr, 0, sizeof(s_rx_addr));
+    s_rx_addr.sin_family = AF_INET;
+    s_rx_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    s_rx_addr.sin_port = 0;
+    bind(s_rx, (struct sockaddr *)&s_rx_addr, sizeof(s_rx_addr));
+
+    socklen_t addr_len = sizeof(s_rx_addr);
+    getsockname(s_rx, (struct sockaddr *)&s_rx_addr, &addr_len);
+
+    struct timeval timeout = { .tv_sec = 1 };
+    setsockopt(s_rx, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+void tearDown(void)
+{
+    close(s_rx);
+    close(s_tx);
+}
+
+// Wysyła pakiet przez loopback i dekoduje to, co przyszło
+static int loopback_decode(teleplot_bin_dict_t *rx_dict, const uint8_t *pkt, size_t len,
+                           char *text, size_t text_size)
+{
+    uint8_t received[1500];
+    TEST_ASSERT_EQUAL_INT((int)len, (int)sendto(s_tx, pkt, len, 0,
+                          (struct sockaddr *)&s_rx_addr, sizeof(s_rx_addr)));
+    ssize_t n = recv(s_rx, received, sizeof(received), 0);
+    TEST_ASSERT_EQUAL_INT((int)len, (int)n);
+
+    int text_len = teleplot_bin_decode(rx_dict, received, (size_t)n, text, text_size - 1);
+    if (text_len >= 0) {
+        text[text_len] = '\0';
+    }
+    return text_len;
+}
+
+void test_dict_and_data_round_trip_over_loopback(void)
+{
+    static teleplot_bin_dict_t tx_dict;
+    static teleplot_bin_dict_t rx_dict;
+    memset(&tx_dict, 0, sizeof(tx_dict));
+    memset(&rx_dict, 0, sizeof(rx_dict));
+
+    uint8_t pkt[1400];
+    char text[512];
+    bool added;
+
+    TEST_ASSERT_EQUAL_INT(0, teleplot_bin_register(&tx_dict, "temp", TELEPLOT_BIN_I16, 2));
+    TEST_ASSERT_EQUAL_INT(1, teleplot_bin_channel_id(&tx_dict, "sinus", &added));
+    TEST_ASSERT_TRUE(added);
+    TEST_ASSERT_EQUAL_INT(1, teleplot_bin_channel_id(&tx_dict, "sinus", &added));
+    TEST_ASSERT_FALSE(added);
+
+    uint8_t next = 0;
+    size_t dict_len = teleplot_bin_write_dict(&tx_dict, pkt, sizeof(pkt), &next);
+    TEST_ASSERT_EQUAL_INT(2, next);
+    TEST_ASSERT_EQUAL_INT(0, loopback_decode(&rx_dict, pkt, dict_len, text, sizeof(text)));
+
+    teleplot_bin_frame_t frame;
+    teleplot_bin_frame_begin(&tx_dict, &frame, pkt, sizeof(pkt));
+    TEST_ASSERT_TRUE(teleplot_bin_frame_add(&tx_dict, &frame, 1, 1234567, 12.3456f));
+    TEST_ASSERT_TRUE(teleplot_bin_frame_add(&tx_dict, &frame, 0, 1234817, 21.4375f));
+    TEST_ASSERT_TRUE(teleplot_bin_frame_add(&tx_dict, &frame, 1, 1300000, -99.5f));
+
+    // nagłówek 6 + base_ms 4 + count 1 + (1+2+4) + (1+2+2) + (1+2+4)
+    TEST_ASSERT_EQUAL_INT(30, (int)frame.len);
+
+    // Czas próbek jest zaokrąglany do TELEPLOT_BIN_DT_UNIT_US
+    int len = loopback_decode(&rx_dict, pkt, frame.len, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("sinus:1234.500:12.346|g\n"
+                             "temp:1234.800:21.44|g\n"
+                             "sinus:1300.000:-99.500|g", text);
+    TEST_ASSERT_EQUAL_INT((int)strlen(text), len);
+}
+
+void test_full_frame_fits_max_text(void)
+{
+    static teleplot_bin_dict_t tx_dict;
+    static teleplot_bin_dict_t rx_dict;
+    static char text[TELEPLOT_BIN_MAX_TEXT + 1];
+    memset(&tx_dict, 0, sizeof(tx_dict));
+    memset(&rx_dict, 0, sizeof(rx_dict));
+
+    // Najgorszy przypadek: najdłuższa nazwa, najdłuższy czas i wartość
+    uint8_t pkt[1400];
+    const char *name = "abcdefghijklmnopqrstuvwxyz01234";
+    TEST_ASSERT_EQUAL_INT(TELEPLOT_BIN_MAX_NAME, (int)strlen(name));
+    TEST_ASSERT_EQUAL_INT(0, teleplot_bin_register(&tx_dict, name, TELEPLOT_BIN_F32, 0));
+    uint8_t next = 0;
+    size_t dict_len = teleplot_bin_write_dict(&tx_dict, pkt, sizeof(pkt), &next);
+    TEST_ASSERT_EQUAL_INT(0, loopback_decode(&rx_dict, pkt, dict_len, text, sizeof(text)));
+
+    teleplot_bin_frame_t frame;
+    teleplot_bin_frame_begin(&tx_dict, &frame, pkt, sizeof(pkt));
+    int64_t timestamp_us = (int64_t)UINT32_MAX * 1000;
+    while (teleplot_bin_frame_add(&tx_dict, &frame, 0, timestamp_us, -1.8e19f)) {
+    }
+    TEST_ASSERT_TRUE(frame.count > 150);
+
+    int len = loopback_decode(&rx_dict, pkt, frame.len, text, sizeof(text));
+    TEST_ASSERT_TRUE(len > 8192);
+    TEST_ASSERT_TRUE(len <= TELEPLOT_BIN_MAX_TEXT);
+    TEST_ASSERT_EQUAL_UINT32(0, rx_dict.skipped_samples);
+    // Każda linia mieści się w TELEPLOT_BIN_MAX_LINE
+    char *first_newline = strchr(text, '\n');
+    TEST_ASSERT_TRUE(first_newline != NULL && first_newline - text <= TELEPLOT_BIN_MAX_LINE);
+}
+
+void test_out_of_range_value_skips_one_sample(void)
+{
+    static teleplot_bin_dict_t tx_dict;
+    static teleplot_bin_dict_t rx_dict;
+    memset(&tx_dict, 0, sizeof(tx_dict));
+    memset(&rx_dict, 0, sizeof(rx_dict));
+
+    uint8_t pkt[256];
+    char text[256];
+    teleplot_bin_channel_id(&tx_dict, "v", NULL);
+    uint8_t next = 0;
+    size_t dict_len = teleplot_bin_write_dict(&tx_dict, pkt, sizeof(pkt), &next);
+    TEST_ASSERT_EQUAL_INT(0, loopback_decode(&rx_dict, pkt, dict_len, text, sizeof(text)));
+
+    // 1e30 z trzema miejscami po przecinku nie mieści się w formatterze
+    teleplot_bin_frame_t frame;
+    teleplot_bin_frame_begin(&tx_dict, &frame, pkt, sizeof(pkt));
+    teleplot_bin_frame_add(&tx_dict, &frame, 0, 1000, 1.0f);
+    teleplot_bin_frame_add(&tx_dict, &frame, 0, 2000, 1e30f);
+    teleplot_bin_frame_add(&tx_dict, &frame, 0, 3000, 3.0f);
+
+    int len = loopback_decode(&rx_dict, pkt, frame.len, text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("v:1.000:1.000|g\nv:3.000:3.000|g", text);
+    TEST_ASSERT_EQUAL_INT((int)strlen(text), len);
+    TEST_ASSERT_EQUAL_UINT32(1, rx_dict.skipped_samples);
+}
+
+void test_data_before_dict_is_dropped(void)
+{
+    static teleplot_bin_dict_t tx_dict;
+    static teleplot_bin_dict_t rx_dict;
+    memset(&tx_dict, 0, sizeof(tx_dict));
+    memset(&rx_dict, 0, sizeof(rx_dict));
+
+    uint8_t pkt[64];
+    char text[64];
+    teleplot_bin_channel_id(&tx_dict, "counter", NULL);
+
+    teleplot_bin_frame_t frame;
+    teleplot_bin_frame_begin(&tx_dict, &frame, pkt, sizeof(pkt));
+    teleplot_bin_frame_add(&tx_dict, &frame, 0, 1000, 1.0f);
+    teleplot_bin_frame_add(&tx_dict, &frame, 0, 2000, 2.0f);
+
+    TEST_ASSERT_EQUAL_INT(0, loopback_decode(&rx_dict, pkt, frame.len, text, sizeof(text)));
+    TEST_ASSERT_EQUAL_UINT32(2, rx_dict.unknown_samples);
+}
+
+void test_sample_outside_dt_range_needs_new_frame(void)
+{
+    static teleplot_bin_dict_t tx_dict;
+    memset(&tx_dict, 0, sizeof(tx_dict));
+
+    uint8_t pkt[64];
+    teleplot_bin_channel_id(&tx_dict, "temp", NULL);
+
+    teleplot_bin_frame_t frame;
+    teleplot_bin_frame_begin(&tx_dict, &frame, pkt, sizeof(pkt));
+    TEST_ASSERT_TRUE(teleplot_bin_frame_add(&tx_dict, &frame, 0, 10000000, 1.0f));
+    TEST_ASSERT_TRUE(teleplot_bin_frame_add(&tx_dict, &frame, 0, 9000000, 2.0f));
+    TEST_ASSERT_FALSE(teleplot_bin_frame_add(&tx_dict, &frame, 0, 14000000, 3.0f));
+    TEST_ASSERT_EQUAL_INT(2, frame.count);
+}
+
+void test_large_dict_is_split_across_packets(void)
+{
+    static teleplot_bin_dict_t tx_dict;
+    static teleplot_bin_dict_t rx_dict;
+    memset(&tx_dict, 0, sizeof(tx_dict));
+    memset(&rx_dict, 0, sizeof(rx_dict));
+
+    static char names[TELEPLOT_BIN_MAX_CHANNELS][TELEPLOT_BIN_MAX_NAME + 1];
+    for (int i = 0; i < TELEPLOT_BIN_MAX_CHANNELS; i++) {
+        snprintf(names[i], sizeof(names[i]), "channel_with_long_name_%02d", i);
+        TEST_ASSERT_EQUAL_INT(i, teleplot_bin_channel_id(&tx_dict, names[i], NULL));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, teleplot_bin_channel_id(&tx_dict, "one_too_many", NULL));
+
+    uint8_t pkt[1400];
+    char text[64];
+    uint8_t next = 0;
+    int packets = 0;
+    while (next < tx_dict.count) {
+        size_t len = teleplot_bin_write_dict(&tx_dict, pkt, sizeof(pkt), &next);
+        TEST_ASSERT_TRUE(len > 0 && len <= sizeof(pkt));
+        TEST_ASSERT_EQUAL_INT(0, loopback_decode(&rx_dict, pkt, len, text, sizeof(text)));
+        packets++;
+    }
+    TEST_ASSERT_EQUAL_INT(2, packets);
+    for (int i = 0; i < TELEPLOT_BIN_MAX_CHANNELS; i++) {
+        TEST_ASSERT_TRUE(rx_dict.known[i]);
+        TEST_ASSERT_EQUAL_STRING(names[i], rx_dict.channels[i].name);
+    }
+}
+
+void test_malformed_packets_are_rejected(void)
+{
+    static teleplot_bin_dict_t rx_dict;
+    memset(&rx_dict, 0, sizeof(rx_dict));
+    char text[64];
+
+    const uint8_t bad_magic[] = { 'X', 'B', TELEPLOT_BIN_VERSION, TELEPLOT_BIN_PKT_DATA, 0, 0 };
+    const uint8_t truncated_dict[] = { 'T', 'B', TELEPLOT_BIN_VERSION, TELEPLOT_BIN_PKT_DICT, 0, 0,
+                                       1, 0, TELEPLOT_BIN_F32, 3, 10, 'a' };
+    TEST_ASSERT_EQUAL_INT(-1, teleplot_bin_decode(&rx_dict, bad_magic, sizeof(bad_magic),
+                                                  text, sizeof(text)));
+    TEST_ASSERT_EQUAL_INT(-1, teleplot_bin_decode(&rx_dict, truncated_dict, sizeof(truncated_dict),
+                                                  text, sizeof(text)));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_dict_and_data_round_trip_over_loopback);
+    RUN_TEST(test_full_frame_fits_max_text);
+    RUN_TEST(test_out_of_range_value_skips_one_sample);
+    RUN_TEST(test_data_before_dict_is_dropped);
+    RUN_TEST(test_sample_outside_dt_range_needs_new_frame);
+    RUN_TEST(test_large_dict_is_split_across_packets);
+    RUN_TEST(test_malformed_packets_are_rejected);
+
+    return UNITY_END();
+}
@@ -0,0 +1,172 @@
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "teleplot_format.h"
+
+#define BENCH_SAMPLES 200000
+
+static float s_values[BENCH_SAMPLES];
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Losowe wartości z szerokiego zakresu wykładników, jak realne kanały telemetrii
+static float random_value(void)
+{
+    float mantissa = (float)rand() / RAND_MAX * 2.0f - 1.0f;
+    return ldexpf(mantissa, rand() % 40 - 20);
+}
+
+static void assert_same_as_snprintf(float value, int decimals)
+{
+    char expected[64];
+    char actual[64];
+    int expected_len = snprintf(expected, sizeof(expected), "%.*f", decimals, value);
+    int actual_len = teleplot_format_fixed(actual, sizeof(actual), value, decimals);
+    actual[actual_len < 0 ? 0 : actual_len] = '\0';
+    TEST_ASSERT_EQUAL_STRING(expected, actual);
+    TEST_ASSERT_EQUAL_INT(expected_len, actual_len);
+}
+
+void test_edge_cases_match_snprintf(void)
+{
+    static const float values[] = {
+        0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 1.5f, 2.5f, -2.5f, 0.125f, 0.375f,
+        0.0005f, -0.0004f, 999.9995f, 123456.789f, 16777216.0f, 1e12f,
+        -1e-9f, 3.14159265f, 25.0625f, -55.0f, 125.0f, INFINITY, -INFINITY, NAN,
+    };
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        for (int d = 0; d <= 6; d++) {
+            assert_same_as_snprintf(values[i], d);
+        }
+    }
+}
+
+void test_random_values_match_snprintf(void)
+{
+    srand(1234);
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        assert_same_as_snprintf(random_value(), i % (TELEPLOT_FORMAT_MAX_DECIMALS + 1));
+    }
+}
+
+void test_metric_line(void)
+{
+    char buf[32];
+    int len = teleplot_format_metric(buf, sizeof(buf), "temp", 21.4375f, 3);
+    TEST_ASSERT_EQUAL_STRING_LEN("temp:21.438|g", buf, 13);
+    TEST_ASSERT_EQUAL_INT(13, len);
+
+    len = teleplot_format_metric_at(buf, sizeof(buf), "temp", 1234567, 21.4375f, 3);
+    TEST_ASSERT_EQUAL_STRING_LEN("temp:1234.567:21.438|g", buf, 22);
+    TEST_ASSERT_EQUAL_INT(22, len);
+    len = teleplot_format_metric_at(buf, sizeof(buf), "t", 42, -1.0f, 0);
+    TEST_ASSERT_EQUAL_STRING_LEN("t:0.042:-1|g", buf, 12);
+    TEST_ASSERT_EQUAL_INT(12, len);
+
+    // Linia, która się nie mieści, nie jest zapisywana częściowo
+    TEST_ASSERT_EQUAL_INT(-1, teleplot_format_metric(buf, 12, "temp", 21.4375f, 3));
+    TEST_ASSERT_EQUAL_INT(-1, teleplot_format_metric_at(buf, 21, "temp", 1234567, 21.4375f, 3));
+    TEST_ASSERT_EQUAL_INT(-1, teleplot_format_fixed(buf, sizeof(buf), 1e30f, 3));
+}
+
+void test_append_fills_batch_exactly(void)
+{
+    // Strażnik za buforem wykrywa zapis poza datagramem
+    struct {
+        char batch[1400];
+        char guard[128];
+    } datagram;
+    char name[128];
+    size_t len = 0;
+    memset(&datagram, 0, sizeof(datagram));
+    memset(datagram.guard, 0x5A, sizeof(datagram.guard));
+
+    // "n:1.000:2.000|g" - linia ma 14 bajtów plus nazwa
+    int base = teleplot_format_metric_at(name, sizeof(name), "", 1000, 2.0f, 3);
+    TEST_ASSERT_EQUAL_INT(14, base);
+
+    // Linie 40-bajtowe, a ostatnia dopasowana tak, by zająć bufor co do bajtu
+    memset(name, 'a', 26);
+    name[26] = '\0';
+    while (sizeof(datagram.batch) - len > 2 * 41) {
+        TEST_ASSERT_TRUE(teleplot_format_append_at(datagram.batch, sizeof(datagram.batch), &len,
+                                                   name, 1000, 2.0f, 3));
+    }
+    size_t last = sizeof(datagram.batch) - len - 1 - base;
+    memset(name, 'z', last);
+    name[last] = '\0';
+    TEST_ASSERT_TRUE(teleplot_format_append_at(datagram.batch, sizeof(datagram.batch), &len,
+                                               name, 1000, 2.0f, 3));
+    TEST_ASSERT_EQUAL_INT(sizeof(datagram.batch), len);
+    TEST_ASSERT_EQUAL_INT('g', datagram.batch[sizeof(datagram.batch) - 1]);
+
+    // Kolejna próbka: odrzucona, nic nie zapisane
+    TEST_ASSERT_FALSE(teleplot_format_append_at(datagram.batch, sizeof(datagram.batch), &len,
+                                                "x", 1000, 2.0f, 3));
+    TEST_ASSERT_EQUAL_INT(sizeof(datagram.batch), len);
+    for (size_t i = 0; i < sizeof(datagram.guard); i++) {
+        TEST_ASSERT_EQUAL_INT(0x5A, datagram.guard[i]);
+    }
+
+    // Po wysłaniu (len = 0) ta sama próbka trafia na początek
+    len = 0;
+    TEST_ASSERT_TRUE(teleplot_format_append_at(datagram.batch, sizeof(datagram.batch), &len,
+                                               "x", 1000, 2.0f, 3));
+    TEST_ASSERT_EQUAL_INT(15, len);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(datagram.batch, "x:1.000:2.000|g", 15));
+}
+
+void test_benchmark_against_snprintf(void)
+{
+    char buf[64];
+    char message[128];
+    volatile int sink = 0;
+
+    srand(42);
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        s_values[i] = random_value() * 1000.0f;
+    }
+
+    double start = now_seconds();
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        sink += snprintf(buf, sizeof(buf), "%s:%.3f|g", "sinus", s_values[i]);
+    }
+    double snprintf_time = now_seconds() - start;
+
+    start = now_seconds();
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        sink += teleplot_format_metric(buf, sizeof(buf), "sinus", s_values[i], 3);
+    }
+    double fixed_time = now_seconds() - start;
+
+    snprintf(message, sizeof(message),
+             "snprintf: %.0f lines/s, teleplot_format_metric: %.0f lines/s (x%.1f)",
+             BENCH_SAMPLES / snprintf_time, BENCH_SAMPLES / fixed_time,
+             snprintf_time / fixed_time);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(sink > 0);
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_edge_cases_match_snprintf);
+    RUN_TEST(test_random_values_match_snprintf);
+    RUN_TEST(test_metric_line);
+    RUN_TEST(test_append_fills_batch_exactly);
+    RUN_TEST(test_benchmark_against_snprintf);
+
+    return UNITY_END();
+}
@@ -0,0 +1,109 @@
+#include <unity.h>
+#include <string.h>
+#include "wifi_reconnect.h"
+
+static wifi_reconnect_t s_rc;
+
+void setUp(void)
+{
+    wifi_reconnect_init(&s_rc, true);
+}
+
+void tearDown(void) {}
+
+static wifi_cache_t make_cache(const char *ssid, uint8_t channel)
+{
+    wifi_cache_t cache;
+    memset(&cache, 0, sizeof(cache));
+    cache.version = WIFI_CACHE_VERSION;
+    cache.channel = channel;
+    strncpy(cache.ssid, ssid, sizeof(cache.ssid) - 1);
+    return cache;
+}
+
+static void test_cache_validation(void)
+{
+    wifi_cache_t cache = make_cache("gear22", 6);
+    TEST_ASSERT_TRUE(wifi_cache_valid(&cache, "gear22"));
+    TEST_ASSERT_FALSE(wifi_cache_valid(&cache, "gear2"));
+
+    cache.channel = 0;
+    TEST_ASSERT_FALSE(wifi_cache_valid(&cache, "gear22"));
+    cache.channel = 6;
+    cache.version = WIFI_CACHE_VERSION + 1;
+    TEST_ASSERT_FALSE(wifi_cache_valid(&cache, "gear22"));
+
+    // Erased NVS reads back as zeros
+    memset(&cache, 0, sizeof(cache));
+    TEST_ASSERT_FALSE(wifi_cache_valid(&cache, "gear22"));
+}
+
+static void test_fast_connect_then_scan(void)
+{
+    TEST_ASSERT_EQUAL_INT(WIFI_CONNECT_FAST, wifi_reconnect_mode(&s_rc));
+    for (int i = 0; i < WIFI_FAST_CONNECT_ATTEMPTS; i++) {
+        TEST_ASSERT_EQUAL_INT(WIFI_CONNECT_FAST, wifi_reconnect_mode(&s_rc));
+        wifi_reconnect_failed(&s_rc, 0);
+    }
+    TEST_ASSERT_EQUAL_INT(WIFI_CONNECT_SCAN, wifi_reconnect_mode(&s_rc));
+
+    // A scan found the AP: the next drop goes straight back to it
+    wifi_reconnect_connected(&s_rc);
+    TEST_ASSERT_EQUAL_INT(WIFI_CONNECT_FAST, wifi_reconnect_mode(&s_rc));
+}
+
+static void test_no_cache_scans(void)
+{
+    wifi_reconnect_init(&s_rc, false);
+    TEST_ASSERT_EQUAL_INT(WIFI_CONNECT_SCAN, wifi_reconnect_mode(&s_rc));
+    wifi_reconnect_failed(&s_rc, 0);
+    TEST_ASSERT_EQUAL_INT(WIFI_CONNECT_SCAN, wifi_reconnect_mode(&s_rc));
+}
+
+static void test_backoff_doubles_up_to_limit(void)
+{
+    uint32_t expected = WIFI_BACKOFF_MIN_MS;
+    for (int i = 0; i < 40; i++) {
+        wifi_reconnect_t lo = s_rc;
+        // Both ends of the jitter range
+        TEST_ASSERT_EQUAL_INT(expected, wifi_reconnect_failed(&s_rc, expected / 2));
+        TEST_ASSERT_EQUAL_INT(expected / 2, wifi_reconnect_failed(&lo, 0));
+        expected = expected * 2 > WIFI_BACKOFF_MAX_MS ? WIFI_BACKOFF_MAX_MS : expected * 2;
+    }
+    // Never gives up
+    TEST_ASSERT_EQUAL_INT(40, s_rc.failures);
+    TEST_ASSERT_TRUE(wifi_reconnect_failed(&s_rc, 12345) <= WIFI_BACKOFF_MAX_MS);
+}
+
+static void test_jitter_stays_in_range(void)
+{
+    for (uint32_t r = 0; r < 2000; r += 7) {
+        wifi_reconnect_t rc = s_rc;
+        rc.failures = 3;
+        uint32_t delay = wifi_reconnect_failed(&rc, r * 2654435761u);
+        TEST_ASSERT_TRUE(delay >= WIFI_BACKOFF_MIN_MS * 8 / 2);
+        TEST_ASSERT_TRUE(delay <= WIFI_BACKOFF_MIN_MS * 8);
+    }
+}
+
+static void test_connected_resets_backoff(void)
+{
+    for (int i = 0; i < 10; i++) {
+        wifi_reconnect_failed(&s_rc, 0);
+    }
+    wifi_reconnect_connected(&s_rc);
+    TEST_ASSERT_EQUAL_INT(0, s_rc.failures);
+    TEST_ASSERT_EQUAL_INT(WIFI_BACKOFF_MIN_MS / 2, wifi_reconnect_failed(&s_rc, 0));
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_cache_validation);
+    RUN_TEST(test_fast_connect_then_scan);
+    RUN_TEST(test_no_cache_scans);
+    RUN_TEST(test_backoff_doubles_up_to_limit);
+    RUN_TEST(test_jitter_stays_in_range);
+    RUN_TEST(test_connected_resets_backoff);
+    return UNITY_END();
+}
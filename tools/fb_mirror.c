@@ -0,0 +1,96 @@
+/*
+ * Podgląd zdalny wyświetlacza SSD1306 (Linux).
+ *
+ * Odbiera migawki bufora ramki (SSD1306_SNAPSHOT_ENABLE = 1) i zapisuje
+ * ostatnią z każdego urządzenia jako <katalog>/<ip>.pbm. Plik podmieniany
+ * jest atomowo (zapis do .tmp + rename), więc przeglądarka obrazów
+ * z automatycznym odświeżaniem nigdy nie widzi połowy ramki.
+ *
+ * Budowanie (z katalogu głównego projektu):
+ *   cc -O2 -Iinclude tools/fb_mirror.c src/ssd1306_snapshot.c -o fb_mirror
+ *
+ * Użycie:
+ *   ./fb_mirror [port_nasłuchu=47271] [katalog=.]
+ *
+ * PNG (np. powiększony 4x): pnmscale 4 oled.pbm | pnmtopng > oled.png
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "ssd1306_snapshot.h"
+
+// Zapis przez plik tymczasowy, żeby czytelnik zawsze dostał całą ramkę
+static int write_atomic(const char *path, const uint8_t *data, size_t len) {
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *f = fopen(tmp, "wb");
+    if (!f) {
+        return -1;
+    }
+    size_t written = fwrite(data, 1, len, f);
+    if (fclose(f) != 0 || written != len) {
+        unlink(tmp);
+        return -1;
+    }
+    return rename(tmp, path);
+}
+
+int main(int argc, char **argv) {
+    int listen_port = argc > 1 ? atoi(argv[1]) : 47271;
+    const char *outdir = argc > 2 ? argv[2] : ".";
+
+    int rx = socket(AF_INET, SOCK_DGRAM, 0);
+    if (rx < 0) {
+        perror("socket");
+        return 1;
+    }
+
+    struct sockaddr_in local = {
+        .sin_family = AF_INET,
+        .sin_port = htons(listen_port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    if (bind(rx, (struct sockaddr *)&local, sizeof(local)) < 0) {
+        perror("bind");
+        return 1;
+    }
+
+    printf("Nasłuch na :%d, obrazy w %s/\n", listen_port, outdir);
+
+    static uint8_t pkt[2048];
+    static uint8_t frame[SSD1306_SNAPSHOT_FRAME_SIZE];
+    static uint8_t image[SSD1306_SNAPSHOT_PBM_SIZE];
+
+    for (;;) {
+        struct sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+        ssize_t n = recvfrom(rx, pkt, sizeof(pkt), 0, (struct sockaddr *)&from, &from_len);
+        if (n < 0) {
+            perror("recvfrom");
+            return 1;
+        }
+
+        uint16_t seq;
+        if (ssd1306_snapshot_decode(pkt, (size_t)n, frame, &seq) != 0) {
+            fprintf(stderr, "Odrzucono niepoprawny pakiet (%zd B)\n", n);
+            continue;
+        }
+
+        char ip[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &from.sin_addr, ip, sizeof(ip));
+        char path[448];
+        snprintf(path, sizeof(path), "%s/%s.pbm", outdir, ip);
+
+        size_t len = ssd1306_snapshot_to_pbm(frame, image, sizeof(image));
+        if (write_atomic(path, image, len) != 0) {
+            perror(path);
+            continue;
+        }
+        printf("%s: ramka %u (%zd B)\n", ip, seq, n);
+    }
+}
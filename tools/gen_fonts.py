@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+"""Generate packed SSD1306 glyph tables from the text fonts in tools/fonts.
+
+Usage: gen_fonts.py -o ssd1306_fonts.c tools/fonts/font5x7.txt [...]
+
+Font source format (one file per font):
+
+    name 5x7            C identifier suffix: ssd1306_font_5x7
+    height 7            rows per glyph
+    advance 6           monospace cell width
+    spacing 1           gap after a glyph in proportional mode
+    proportional yes    advance by ink width + spacing instead of the cell
+
+    glyph 0x41 A        character code, then `height` rows of '#' / '.'
+    .###.
+    ...
+
+Glyphs are stored the way the panel's RAM is laid out: one byte per column
+of an 8-pixel page (bit 0 = top row), pages one after another. Empty
+columns on both sides are trimmed; the left bearing is kept in the glyph
+table, so monospace text still lines up.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+class FontError(Exception):
+    pass
+
+
+def parse_font(path):
+    font = {"glyphs": {}, "path": path}
+    current = None
+    with open(path, encoding="ascii") as f:
+        for lineno, raw in enumerate(f, 1):
+            line = raw.rstrip("\n")
+            if not line.strip() or line.startswith("#") and current is None:
+                continue
+            if current is not None and re.fullmatch(r"[#.]+", line):
+                current["rows"].append(line)
+                if len(current["rows"]) == font["height"]:
+                    current = None
+                continue
+            if current is not None:
+                raise FontError(f"{path}:{lineno}: glyph 0x{current['code']:02X} has "
+                                f"{len(current['rows'])} rows, expected {font['height']}")
+
+            key, _, value = line.partition(" ")
+            if key == "glyph":
+                code = int(value.split()[0], 16)
+                if code in font["glyphs"]:
+                    raise FontError(f"{path}:{lineno}: duplicate glyph 0x{code:02X}")
+                current = {"code": code, "rows": []}
+                font["glyphs"][code] = current
+            elif key in ("height", "advance", "spacing"):
+                font[key] = int(value)
+            elif key == "name":
+                if not re.fullmatch(r"[A-Za-z0-9_]+", value):
+                    raise FontError(f"{path}:{lineno}: bad font name '{value}'")
+                font["name"] = value
+            elif key == "proportional":
+                font["proportional"] = value == "yes"
+            else:
+                raise FontError(f"{path}:{lineno}: unknown key '{key}'")
+
+    for key in ("name", "height", "advance", "spacing", "proportional"):
+        if key not in font:
+            raise FontError(f"{path}: missing '{key}'")
+    if current is not None:
+        raise FontError(f"{path}: glyph 0x{current['code']:02X} is truncated")
+    if not font["glyphs"]:
+        raise FontError(f"{path}: no glyphs")
+    return font
+
+
+def pack_glyph(font, glyph):
+    rows = glyph["rows"]
+    width = max(len(r) for r in rows)
+    rows = [r.ljust(width, ".") for r in rows]
+    ink = [x for x in range(width) if any(r[x] == "#" for r in rows)]
+    pages = (font["height"] + 7) // 8
+
+    if not ink:
+        # Blank glyph (space): no bitmap, advance by its source width
+        advance = width if font["proportional"] else font["advance"]
+        return {"xoff": 0, "width": 0, "advance": advance, "bytes": []}
+
+    x0, x1 = ink[0], ink[-1]
+    data = []
+    for page in range(pages):
+        for x in range(x0, x1 + 1):
+            byte = 0
+            for bit in range(8):
+                y = page * 8 + bit
+                if y < font["height"] and rows[y][x] == "#":
+                    byte |= 1 << bit
+            data.append(byte)
+
+    if font["proportional"]:
+        advance = x1 - x0 + 1 + font["spacing"]
+        xoff = 0
+    else:
+        advance = font["advance"]
+        xoff = x0
+    return {"xoff": xoff, "width": x1 - x0 + 1, "advance": advance, "bytes": data}
+
+
+def char_comment(code):
+    c = chr(code)
+    if c == " ":
+        return "' '"
+    if c in "\\'":
+        return "'\\" + c + "'"
+    return f"'{c}'"
+
+
+def emit_font(font, out):
+    name = font["name"]
+    first = min(font["glyphs"])
+    last = max(font["glyphs"])
+    pages = (font["height"] + 7) // 8
+
+    bitmap_lines = []
+    glyph_lines = []
+    offset = 0
+    for code in range(first, last + 1):
+        glyph = font["glyphs"].get(code)
+        if glyph is None:
+            glyph_lines.append(f"    {{ 0, 0, 0, 0 }},  // 0x{code:02X} (missing)")
+            continue
+        packed = pack_glyph(font, glyph)
+        if packed["bytes"]:
+            hex_bytes = ", ".join(f"0x{b:02X}" for b in packed["bytes"])
+            bitmap_lines.append(f"    {hex_bytes},  // {char_comment(code)}")
+        glyph_lines.append(f"    {{ {offset}, {packed['width']}, {packed['xoff']}, {packed['advance']} }},"
+                           f"  // {char_comment(code)}")
+        offset += len(packed["bytes"])
+
+    if offset > 0xFFFF:
+        raise FontError(f"{font['path']}: bitmap too large ({offset} bytes)")
+
+    out.append(f"// {name}: {len(font['glyphs'])} glyphs, {offset} bitmap bytes")
+    out.append(f"static const uint8_t ssd1306_font_{name}_bitmap[] = {{")
+    out.extend(bitmap_lines)
+    out.append("};")
+    out.append("")
+    out.append(f"static const ssd1306_glyph_t ssd1306_font_{name}_glyphs[] = {{")
+    out.extend(glyph_lines)
+    out.append("};")
+    out.append("")
+    out.append(f"const ssd1306_font_t ssd1306_font_{name} = {{")
+    out.append(f"    .bitmap = ssd1306_font_{name}_bitmap,")
+    out.append(f"    .glyphs = ssd1306_font_{name}_glyphs,")
+    out.append(f"    .first = 0x{first:02X},")
+    out.append(f"    .last = 0x{last:02X},")
+    out.append(f"    .height = {font['height']},")
+    out.append(f"    .pages = {pages},")
+    out.append(f"    .advance = {font['advance']},")
+    out.append("};")
+    out.append("")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-o", "--output", required=True, help="generated C file")
+    parser.add_argument("fonts", nargs="+", help="font source files")
+    args = parser.parse_args()
+
+    out = [
+        "// Generated by tools/gen_fonts.py - do not edit.",
+        "// Sources: " + " ".join(os.path.basename(p) for p in args.fonts),
+        "",
+        '#include "ssd1306_font.h"',
+        "",
+    ]
+    try:
+        for path in args.fonts:
+            emit_font(parse_font(path), out)
+    except (FontError, OSError, ValueError) as e:
+        print(f"gen_fonts: {e}", file=sys.stderr)
+        return 1
+
+    with open(args.output, "w", encoding="ascii") as f:
+        f.write("\n".join(out))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
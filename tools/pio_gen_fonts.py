@@ -0,0 +1,16 @@
+# PlatformIO pre-script for the native env: the ESP-IDF build generates the
+# font tables from src/CMakeLists.txt, the host build does it here.
+import os
+import subprocess
+
+Import("env")
+
+project_dir = env.subst("$PROJECT_DIR")
+out_dir = os.path.join(env.subst("$BUILD_DIR"), "generated")
+fonts = [os.path.join(project_dir, "tools", "fonts", name)
+         for name in ("font5x7.txt", "font8x8.txt", "digits16x24.txt")]
+
+os.makedirs(out_dir, exist_ok=True)
+subprocess.check_call([env.subst("$PYTHONEXE"), os.path.join(project_dir, "tools", "gen_fonts.py"),
+                       "-o", os.path.join(out_dir, "ssd1306_fonts.c")] + fonts)
+env.BuildSources(os.path.join("$BUILD_DIR", "generated_obj"), out_dir)
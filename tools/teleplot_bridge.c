@@ -0,0 +1,81 @@
+/*
+ * Mostek binarnego protokołu telemetrii -> tekstowy UDP Teleplot (Linux).
+ *
+ * Odbiera pakiety z urządzenia (TELEPLOT_BINARY_MODE = 1) i przesyła je jako
+ * linie "nazwa:czas_ms:wartość|g" do lokalnego Teleplota.
+ *
+ * Budowanie (z katalogu głównego projektu):
+ *   cc -O2 -Iinclude tools/teleplot_bridge.c src/teleplot_bin.c src/teleplot_format.c -lm -o teleplot_bridge
+ *
+ * Użycie:
+ *   ./teleplot_bridge [port_nasłuchu=47270] [host_teleplot=127.0.0.1] [port_teleplot=47269]
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "teleplot_bin.h"
+
+int main(int argc, char **argv) {
+    int listen_port = argc > 1 ? atoi(argv[1]) : 47270;
+    const char *teleplot_host = argc > 2 ? argv[2] : "127.0.0.1";
+    int teleplot_port = argc > 3 ? atoi(argv[3]) : 47269;
+
+    int rx = socket(AF_INET, SOCK_DGRAM, 0);
+    int tx = socket(AF_INET, SOCK_DGRAM, 0);
+    if (rx < 0 || tx < 0) {
+        perror("socket");
+        return 1;
+    }
+
+    struct sockaddr_in local = {
+        .sin_family = AF_INET,
+        .sin_port = htons(listen_port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    if (bind(rx, (struct sockaddr *)&local, sizeof(local)) < 0) {
+        perror("bind");
+        return 1;
+    }
+
+    struct sockaddr_in teleplot = {
+        .sin_family = AF_INET,
+        .sin_port = htons(teleplot_port),
+    };
+    if (inet_pton(AF_INET, teleplot_host, &teleplot.sin_addr) != 1) {
+        fprintf(stderr, "Niepoprawny adres: %s\n", teleplot_host);
+        return 1;
+    }
+
+    printf("Nasłuch na :%d, przekazywanie do %s:%d\n", listen_port, teleplot_host, teleplot_port);
+
+    // Osobny słownik dla każdego urządzenia byłby potrzebny przy wielu nadawcach;
+    // mostek zakłada jedno urządzenie na port
+    static teleplot_bin_dict_t dict;
+    static uint8_t pkt[2048];
+    static char text[TELEPLOT_BIN_MAX_TEXT];   // Pełny pakiet DATA zawsze się mieści
+
+    for (;;) {
+        ssize_t n = recv(rx, pkt, sizeof(pkt), 0);
+        if (n < 0) {
+            perror("recv");
+            return 1;
+        }
+
+        uint32_t skipped = dict.skipped_samples;
+        int len = teleplot_bin_decode(&dict, pkt, (size_t)n, text, sizeof(text));
+        if (dict.skipped_samples != skipped) {
+            fprintf(stderr, "Pominięto %u próbek z wartością poza zakresem\n",
+                    (unsigned)(dict.skipped_samples - skipped));
+        }
+        if (len < 0) {
+            fprintf(stderr, "Odrzucono niepoprawny pakiet (%zd B)\n", n);
+        } else if (len > 0) {
+            sendto(tx, text, (size_t)len, 0, (struct sockaddr *)&teleplot, sizeof(teleplot));
+        }
+    }
+}